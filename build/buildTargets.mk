@@ -3,7 +3,7 @@
 ################################################################################
 #Allow exectuables to be placed in another directory:
 ALLEXES = $(addprefix $(XD)/, \
- ampsci unitTests wigner dmeXSection periodicTable \
+ ampsci unitTests wigner dmeXSection periodicTable benchmarks \
 )
 
 DEFAULTEXES = $(addprefix $(XD)/, \
@@ -48,6 +48,9 @@ $(XD)/unitTests: $(BD)/unitTests.o $(OBJS)
 $(XD)/dmeXSection: $(BD)/dmeXSection.o $(OBJS)
 	$(LINK)
 
+$(XD)/benchmarks: $(BD)/benchmarks.o $(OBJS)
+	$(LINK)
+
 $(XD)/wigner: $(BD)/wigner.o
 	$(LINK)
 
@@ -275,9 +275,8 @@ double Rk_abcd(const DiracSpinor &Fa, const DiracSpinor &Fc,
   const auto &drdu = Fa.rgrid->drdu;
   const auto i0 = std::max(Fa.p0, Fc.p0);
   const auto imax = std::min(Fa.pinf, Fc.pinf);
-  const auto Rff = NumCalc::integrate(1.0, i0, imax, Fa.f, Fc.f, yk_bd, drdu);
-  const auto Rgg = NumCalc::integrate(1.0, i0, imax, Fa.g, Fc.g, yk_bd, drdu);
-  return (Rff + Rgg) * Fa.rgrid->du;
+  return NumCalc::integrate_fg(Fa.rgrid->du, i0, imax, Fa.f, Fc.f, Fa.g, Fc.g,
+                               yk_bd, drdu);
 }
 
 //******************************************************************************
@@ -1,6 +1,7 @@
 #pragma once
 #include "Angular/Angular_tables.hpp"
 #include "Coulomb/Coulomb.hpp"
+#include "Coulomb/QkTable.hpp"
 #include "Coulomb/YkTable.hpp"
 #include "Maths/NumCalc_quadIntegrate.hpp"
 #include "Wavefunction/Wavefunction.hpp"
@@ -9,6 +10,7 @@
 #include "qip/Vector.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <string>
 
 namespace UnitTest {
@@ -263,6 +265,64 @@ bool Coulomb(std::ostream &obuff) {
     pass &= qip::check_value(&obuff, "Wk_abcd ", worstW, 0.0, 5.0e-14);
   }
 
+  //****************************************************************************
+  { // Test QkTable (symmetry-indexed storage of Q^k_abcd)
+    // nb: only small subset of basis, otherwise slow
+    std::vector<DiracSpinor> orbs;
+    for (const auto &Fn : wf.basis) {
+      if (Fn.n <= 5 && Fn.l() <= 2)
+        orbs.push_back(Fn);
+    }
+    Coulomb::QkTable qk;
+    qk.fill(orbs, Yij);
+
+    double worstQ = 0.0, worstW = 0.0;
+    for (const auto &Fa : orbs) {
+      for (const auto &Fb : orbs) {
+        for (const auto &Fc : orbs) {
+          for (const auto &Fd : orbs) {
+            const auto [kmin, kmax] = Coulomb::k_minmax_W(Fa, Fb, Fc, Fd);
+            for (int k = kmin; k <= kmax; ++k) {
+              const auto dQ =
+                  qk.Q(k, Fa, Fb, Fc, Fd) - Yij.Qk(k, Fa, Fb, Fc, Fd);
+              const auto dW =
+                  qk.W(k, Fa, Fb, Fc, Fd) - Yij.Wk(k, Fa, Fb, Fc, Fd);
+              worstQ = std::max(worstQ, std::abs(dQ));
+              worstW = std::max(worstW, std::abs(dW));
+            }
+          }
+        }
+      }
+    }
+    pass &= qip::check_value(&obuff, "QkTable Q", worstQ, 0.0, 1.0e-14);
+    pass &= qip::check_value(&obuff, "QkTable W", worstW, 0.0, 1.0e-14);
+
+    // Write to disk, read into new table, and compare
+    const std::string fname = "tmp_QkTable_test.qk";
+    qk.read_write(fname, IO::FRW::write, orbs);
+    Coulomb::QkTable qk2;
+    const auto readQ = qk2.read_write(fname, IO::FRW::read, orbs);
+    std::remove(fname.c_str());
+    double worst_rw = readQ ? 0.0 : 1.0;
+    for (const auto &Fa : orbs) {
+      for (const auto &Fb : orbs) {
+        for (const auto &Fc : orbs) {
+          for (const auto &Fd : orbs) {
+            const auto [kmin, kmax] = Coulomb::k_minmax_Q(Fa, Fb, Fc, Fd);
+            for (int k = kmin; k <= kmax; ++k) {
+              const auto dQ =
+                  qk2.Q(k, Fa, Fb, Fc, Fd) - qk.Q(k, Fa, Fb, Fc, Fd);
+              worst_rw = std::max(worst_rw, std::abs(dQ));
+            }
+          }
+        }
+      }
+    }
+    pass &= qip::check_value(&obuff, "QkTable r/w", worst_rw, 0.0, 1.0e-16);
+    pass &= qip::check_value(&obuff, "QkTable r/w size", int(qk2.size()),
+                             int(qk.size()), 0);
+  }
+
   return pass;
 }
 
@@ -0,0 +1,264 @@
+#include "QkTable.hpp"
+#include "Angular/Angular_369j.hpp"
+#include "Angular/Angular_tables.hpp"
+#include "Coulomb/Coulomb.hpp"
+#include "Coulomb/YkTable.hpp"
+#include "IO/FRW_fileReadWrite.hpp"
+#include "IO/SafeProfiler.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#else
+#define omp_get_thread_num() 0
+#define omp_get_max_threads() 1
+#endif
+
+namespace Coulomb {
+
+//******************************************************************************
+void QkTable::set_orbitals(const std::vector<DiracSpinor> &orbs) {
+  m_n.clear();
+  m_kappa.clear();
+  m_en.clear();
+  m_index.clear();
+  m_keys.clear();
+  m_R.clear();
+
+  // Keys pack orbital indexes into 14 bits each
+  assert(orbs.size() < (1ul << 14) && "Too many orbitals for QkTable");
+
+  int max_tj = 1;
+  for (const auto &Fn : orbs) {
+    const auto ki = std::size_t(Angular::indexFromKappa(Fn.k));
+    const auto n = std::size_t(std::max(Fn.n, 0));
+    if (ki >= m_index.size())
+      m_index.resize(ki + 1);
+    if (n >= m_index[ki].size())
+      m_index[ki].resize(n + 1, -1);
+    // Orbitals are looked up by {n, kappa}: must be unique (and n>=0)
+    if (m_index[ki][n] != -1 || Fn.n < 0) {
+      std::cerr << "\nFAIL QkTable: orbitals must have unique {n, kappa} "
+                   "(and n>=0); "
+                << Fn.symbol() << " (n=" << Fn.n << ") is repeated/invalid\n";
+      std::abort();
+    }
+    m_index[ki][n] = int(m_n.size());
+    m_n.push_back(Fn.n);
+    m_kappa.push_back(Fn.k);
+    m_en.push_back(Fn.en);
+    max_tj = std::max(max_tj, Fn.twoj());
+  }
+  m_Ck.fill(max_tj);
+  m_6j.fill(max_tj);
+}
+
+//******************************************************************************
+int QkTable::index(const DiracSpinor &Fa) const {
+  const auto ki = std::size_t(Angular::indexFromKappa(Fa.k));
+  if (Fa.n < 0 || ki >= m_index.size() ||
+      std::size_t(Fa.n) >= m_index[ki].size())
+    return -1;
+  const auto i = m_index[ki][std::size_t(Fa.n)];
+  // nb: energy must match exactly: i.e., must be _same_ orbital
+  return (i >= 0 && m_en[std::size_t(i)] == Fa.en) ? i : -1;
+}
+
+//------------------------------------------------------------------------------
+bool QkTable::contains(const DiracSpinor &Fa) const { return index(Fa) >= 0; }
+
+//------------------------------------------------------------------------------
+std::uint64_t QkTable::key(int k, std::uint64_t a, std::uint64_t b,
+                           std::uint64_t c, std::uint64_t d) {
+  // R^k_abcd symmetric under: a<->c, b<->d, and {ac}<->{bd}
+  if (c < a)
+    std::swap(a, c);
+  if (d < b)
+    std::swap(b, d);
+  if (b < a || (b == a && d < c)) {
+    std::swap(a, b);
+    std::swap(c, d);
+  }
+  return (std::uint64_t(k) << 56) | (a << 42) | (c << 28) | (b << 14) | d;
+}
+
+//******************************************************************************
+void QkTable::fill(const std::vector<DiracSpinor> &orbs, const YkTable &yk,
+                   int k_cut, const SelectionRule &select) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  set_orbitals(orbs);
+
+  // All (unordered) pairs {a,c}: each {ac},{bd} pair-of-pairs is one integral
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  for (std::size_t i = 0; i < orbs.size(); ++i) {
+    for (std::size_t j = i; j < orbs.size(); ++j) {
+      pairs.emplace_back(i, j);
+    }
+  }
+  // Parity: only pairs with same parity of (l_a + l_c) and (l_b + l_d) give
+  // non-zero integrals. Sort pairs by parity (even first), so that the {bd}
+  // loop (below) runs only over pairs of same parity as {ac}
+  const auto num_even = std::size_t(std::distance(
+      begin(pairs),
+      std::stable_partition(begin(pairs), end(pairs), [&](const auto &p) {
+        return (orbs[p.first].l() + orbs[p.second].l()) % 2 == 0;
+      })));
+
+  const auto num_threads = std::size_t(omp_get_max_threads());
+  std::vector<std::vector<std::pair<std::uint64_t, double>>> thread_R(
+      num_threads);
+
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t p1 = 0; p1 < pairs.size(); ++p1) {
+    const auto [ia, ic] = pairs[p1];
+    const auto &Fa = orbs[ia];
+    const auto &Fc = orbs[ic];
+    auto &list = thread_R[std::size_t(omp_get_thread_num())];
+    const auto p2_end = p1 < num_even ? num_even : pairs.size();
+    for (std::size_t p2 = p1; p2 < p2_end; ++p2) {
+      const auto [ib, id] = pairs[p2];
+      const auto &Fb = orbs[ib];
+      const auto &Fd = orbs[id];
+      // nb: includes parity rule; safe to use k+=2
+      auto [kmin, kmax] = k_minmax_Q(Fa, Fb, Fc, Fd);
+      if (k_cut >= 0)
+        kmax = std::min(kmax, k_cut);
+      // Select only called for integrals that are allowed (and required)
+      if (kmin > kmax)
+        continue;
+      if (select && !select(Fa, Fb, Fc, Fd))
+        continue;
+
+      const auto kmin_bd = k_minmax(Fb, Fd).first;
+      const auto &ybd = yk.get_y_ab(Fb, Fd);
+      for (int k = kmin; k <= kmax; k += 2) {
+        const auto &ykbd = ybd[std::size_t(k - kmin_bd)];
+        list.emplace_back(key(k, ia, ib, ic, id), Rk_abcd(Fa, Fc, ykbd));
+      }
+    }
+  }
+
+  // Merge, and sort by key (for look-up)
+  std::vector<std::pair<std::uint64_t, double>> all;
+  all.reserve(std::accumulate(
+      cbegin(thread_R), cend(thread_R), std::size_t{0},
+      [](std::size_t s, const auto &l) { return s + l.size(); }));
+  for (auto &list : thread_R) {
+    all.insert(end(all), cbegin(list), cend(list));
+    list = {};
+  }
+  std::sort(begin(all), end(all),
+            [](const auto &x, const auto &y) { return x.first < y.first; });
+
+  m_keys.reserve(all.size());
+  m_R.reserve(all.size());
+  for (const auto &[kk, R] : all) {
+    m_keys.push_back(kk);
+    m_R.push_back(R);
+  }
+}
+
+//******************************************************************************
+std::optional<double> QkTable::Q_opt(int k, const DiracSpinor &Fa,
+                                     const DiracSpinor &Fb,
+                                     const DiracSpinor &Fc,
+                                     const DiracSpinor &Fd) const {
+  const auto ia = index(Fa);
+  const auto ib = index(Fb);
+  const auto ic = index(Fc);
+  const auto id = index(Fd);
+  if (ia < 0 || ib < 0 || ic < 0 || id < 0)
+    return std::nullopt;
+
+  // These are not stored, but are known to be zero
+  if (k < 0 || !Angular::Ck_kk_SR(k, Fa.k, Fc.k) ||
+      !Angular::Ck_kk_SR(k, Fb.k, Fd.k))
+    return 0.0;
+
+  const auto kk = key(k, std::uint64_t(ia), std::uint64_t(ib),
+                      std::uint64_t(ic), std::uint64_t(id));
+  const auto it = std::lower_bound(cbegin(m_keys), cend(m_keys), kk);
+  if (it == cend(m_keys) || *it != kk)
+    return std::nullopt;
+  const auto R = m_R[std::size_t(it - cbegin(m_keys))];
+
+  const auto tCac = m_Ck.get_tildeCkab(k, Fa.k, Fc.k);
+  const auto tCbd = m_Ck.get_tildeCkab(k, Fb.k, Fd.k);
+  const auto m1tk = Angular::evenQ(k) ? 1 : -1;
+  return m1tk * tCac * tCbd * R;
+}
+
+//------------------------------------------------------------------------------
+double QkTable::P(int k, const DiracSpinor &Fa, const DiracSpinor &Fb,
+                  const DiracSpinor &Fc, const DiracSpinor &Fd) const {
+  // P^k_abcd = [k] sum_l {a,c,k;b,d,l} Q^l_abdc [nb: index order!]
+  if (!contains(Fa) || !contains(Fb) || !contains(Fc) || !contains(Fd))
+    return 0.0;
+  const auto min_l = std::max(std::abs(Fb.twoj() - Fc.twoj()),
+                              std::abs(Fa.twoj() - Fd.twoj())) /
+                     2;
+  const auto max_l =
+      std::min(Fb.twoj() + Fc.twoj(), Fa.twoj() + Fd.twoj()) / 2;
+  double sum = 0.0;
+  for (int l = min_l; l <= max_l; ++l) {
+    if (!Angular::Ck_kk_SR(l, Fb.k, Fc.k) || !Angular::Ck_kk_SR(l, Fa.k, Fd.k))
+      continue;
+    const auto sj =
+        m_6j.get_6j(Fc.twoj(), Fa.twoj(), Fd.twoj(), Fb.twoj(), k, l);
+    if (Angular::zeroQ(sj))
+      continue;
+    sum += sj * Q(l, Fa, Fb, Fd, Fc);
+  }
+  return (2 * k + 1) * sum;
+}
+
+//******************************************************************************
+bool QkTable::read_write(const std::string &fname, IO::FRW::RoW rw,
+                         const std::vector<DiracSpinor> &orbs) {
+  const auto readQ = rw == IO::FRW::read;
+
+  if (readQ && !IO::FRW::file_exists(fname))
+    return false;
+
+  std::fstream iofs;
+  IO::FRW::open_binary(iofs, fname, rw);
+
+  if (readQ)
+    set_orbitals(orbs);
+
+  // Orbitals must match exactly (since use their index in keys)
+  std::size_t num_orbs = m_n.size();
+  rw_binary(iofs, rw, num_orbs);
+  if (readQ && num_orbs != m_n.size()) {
+    std::cout << "\nCannot read Qk table from " << fname
+              << ". Orbital mis-match\n";
+    set_orbitals({});
+    return false;
+  }
+  for (std::size_t i = 0; i < num_orbs; ++i) {
+    auto n = m_n[i];
+    auto kappa = m_kappa[i];
+    auto en = m_en[i];
+    rw_binary(iofs, rw, n, kappa, en);
+    if (readQ && (n != m_n[i] || kappa != m_kappa[i] ||
+                  std::abs(en - m_en[i]) > 1.0e-10 * std::abs(en))) {
+      std::cout << "\nCannot read Qk table from " << fname
+                << ". Orbital mis-match\n";
+      set_orbitals({});
+      return false;
+    }
+  }
+
+  rw_binary(iofs, rw, m_keys, m_R);
+  return true;
+}
+
+} // namespace Coulomb
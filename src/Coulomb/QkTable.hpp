@@ -0,0 +1,115 @@
+#pragma once
+#include "Angular/Angular_tables.hpp"
+#include "IO/FRW_fileReadWrite.hpp"
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+class DiracSpinor;
+
+namespace Coulomb {
+class YkTable;
+
+//! @brief Calculates + stores Q^k_abcd Coulomb integrals for set of orbitals
+/*! @details
+Stores the radial integrals R^k_abcd, which have the 8-fold symmetry:
+R_abcd = R_cbad = R_adcb = R_cdab = R_badc = R_bcda = R_dabc = R_dcba;
+only a single (normalised) ordering is stored. The angular factors are applied
+on look-up:
+
+\f[Q^k_{abcd} = (-1)^k \langle a||C^k||c\rangle \langle b||C^k||d\rangle
+R^k_{abcd}\f]
+
+Only integrals allowed by angular selection rules are stored. Integrals are
+stored in a flat array, sorted by (packed) key; look-up is via binary search.
+
+ - Orbitals are identified by {n, kappa} _and_ energy; so look-up of a state
+   with same {n,kappa} but different energy (e.g., valence HF state vs. the
+   spline basis state) will not be found
+ - Use of the SelectionRule allows only a subset of the integrals to be stored
+   (e.g., only those with two core states) - this can save a lot of memory. It
+   is called for one ordering of {abcd} only (must respect symmetry of R^k)
+*/
+class QkTable {
+public:
+  //! Return true if R^k_abcd should be stored. Called once for each {abcd}
+  //! allowed by angular (triangle, parity) selection rules
+  using SelectionRule =
+      std::function<bool(const DiracSpinor &Fa, const DiracSpinor &Fb,
+                         const DiracSpinor &Fc, const DiracSpinor &Fd)>;
+
+  QkTable() = default;
+
+  //! Calculates all Q^k_abcd with a,b,c,d in orbs, and k<=k_cut (if k_cut>=0)
+  /*! @details yk must be constructed with single set of orbitals, that
+  includes (at least) all those in orbs. If select is given, only those
+  integrals for which select(a,b,c,d) is true are stored. Calculated in
+  parallel. Overwrites any existing values. Each orbital in orbs must have a
+  unique {n, kappa}, with n>=0 (aborts otherwise).
+  */
+  void fill(const std::vector<DiracSpinor> &orbs, const YkTable &yk,
+            int k_cut = -1, const SelectionRule &select = nullptr);
+
+  //! Returns Q^k_abcd, if it is stored. Otherwise, returns std::nullopt
+  std::optional<double> Q_opt(int k, const DiracSpinor &Fa,
+                              const DiracSpinor &Fb, const DiracSpinor &Fc,
+                              const DiracSpinor &Fd) const;
+
+  //! Returns Q^k_abcd; zero if not stored
+  double Q(int k, const DiracSpinor &Fa, const DiracSpinor &Fb,
+           const DiracSpinor &Fc, const DiracSpinor &Fd) const {
+    return Q_opt(k, Fa, Fb, Fc, Fd).value_or(0.0);
+  }
+
+  //! Exchange part: P^k_abcd = [k] sum_l {a,c,k;b,d,l} Q^l_abdc
+  //! @details Any Q^l_abdc not stored are taken to be zero
+  double P(int k, const DiracSpinor &Fa, const DiracSpinor &Fb,
+           const DiracSpinor &Fc, const DiracSpinor &Fd) const;
+
+  //! W^k_abcd = Q^k_abcd + P^k_abcd
+  double W(int k, const DiracSpinor &Fa, const DiracSpinor &Fb,
+           const DiracSpinor &Fc, const DiracSpinor &Fd) const {
+    return Q(k, Fa, Fb, Fc, Fd) + P(k, Fa, Fb, Fc, Fd);
+  }
+
+  //! Returns true if Fa is one of the tabulated orbitals
+  bool contains(const DiracSpinor &Fa) const;
+
+  //! Index of Fa in the list of tabulated orbitals (in the order given to
+  //! fill), or -1 if not found. Constant-time look-up.
+  int index(const DiracSpinor &Fa) const;
+
+  //! Number of stored (independent) integrals
+  std::size_t size() const { return m_R.size(); }
+  //! Memory used by table, in bytes (approx)
+  std::size_t bytes() const {
+    return m_R.size() * (sizeof(double) + sizeof(std::uint64_t));
+  }
+
+  //! Reads/writes table to binary file.
+  /*! @details On read, returns false (and leaves table empty) if file doesn't
+  exist, or if orbitals don't match those in orbs. orbs is not used on write.
+  */
+  bool read_write(const std::string &fname, IO::FRW::RoW rw,
+                  const std::vector<DiracSpinor> &orbs);
+
+private:
+  // {n, kappa, energy} of each orbital (in order)
+  std::vector<int> m_n{}, m_kappa{};
+  std::vector<double> m_en{};
+  // m_index[kappa_index][n] = index in above list (or -1)
+  std::vector<std::vector<int>> m_index{};
+  // sorted keys, and corresponding R^k values
+  std::vector<std::uint64_t> m_keys{};
+  std::vector<double> m_R{};
+  Angular::Ck_ab m_Ck{};
+  Angular::SixJ m_6j{};
+
+  void set_orbitals(const std::vector<DiracSpinor> &orbs);
+  // Normalised key, according to symmetry of R^k_abcd
+  static std::uint64_t key(int k, std::uint64_t a, std::uint64_t b,
+                           std::uint64_t c, std::uint64_t d);
+};
+
+} // namespace Coulomb
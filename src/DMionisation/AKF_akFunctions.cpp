@@ -181,13 +181,11 @@ int calculateK_nk(const Wavefunction &wf, std::size_t is, int max_L, double dE,
         continue;
       //#pragma omp parallel for
       for (int iq = 0; iq < qsteps; iq++) {
-        double a = 0.;
         auto maxj = psi.pinf; // don't bother going further
-        double af = NumCalc::integrate(1.0, 0, maxj, psi.f, phic.f,
-                                       jLqr_f[L][iq], wf.rgrid->drdu);
-        double ag = NumCalc::integrate(1.0, 0, maxj, psi.g, phic.g,
-                                       jLqr_f[L][iq], wf.rgrid->drdu);
-        a = af + ag;
+        // f and g parts in one pass (share jL and drdu)
+        const double a =
+            NumCalc::integrate_fg(1.0, 0, maxj, psi.f, phic.f, psi.g, phic.g,
+                                  jLqr_f[L][iq], wf.rgrid->drdu);
         AK_nk_q[iq] += (float)(dC_Lkk * std::pow(a * wf.rgrid->du, 2) * x_ocf);
       } // q
     }   // END loop over cntm states (ic)
@@ -6,6 +6,7 @@
 #include "Maths/NumCalc_quadIntegrate.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
 #include "qip/Vector.hpp"
+#include <cassert>
 #include <vector>
 /*
 
@@ -57,12 +58,8 @@ void solve_inhomog(DiracSpinor &Fa, DiracSpinor &Fzero, DiracSpinor &Finf,
 
 namespace Adams {
 //******************************************************************************
-void GreenSolution(DiracSpinor &Fa, const DiracSpinor &Finf,
-                   const DiracSpinor &Fzero, const double alpha,
-                   const DiracSpinor &Sr) {
-  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
-
-  // Wronskian: Should be independent of r
+double Wronskian(const DiracSpinor &Finf, const DiracSpinor &Fzero) {
+  // Should be independent of r; average over few points
   const auto pp = std::size_t(0.65 * double(Finf.pinf));
   auto w2 = (Finf.f[pp] * Fzero.g[pp] - Fzero.f[pp] * Finf.g[pp]);
   int f = 1;
@@ -70,43 +67,65 @@ void GreenSolution(DiracSpinor &Fa, const DiracSpinor &Finf,
     ++f;
     w2 += (Finf.f[pt] * Fzero.g[pt] - Fzero.f[pt] * Finf.g[pt]);
   }
-  w2 /= f;
+  return w2 / f;
+}
+
+//******************************************************************************
+void GreenSolution(DiracSpinor &Fa, const DiracSpinor &Finf,
+                   const DiracSpinor &Fzero, const double alpha,
+                   const DiracSpinor &Sr) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  assert(&Fa != &Sr && "Source and solution cannot be the same spinor");
 
-  // std::vector<double> invW2(Finf.f.size());
-  // for (std::size_t i = 0; i < Finf.pinf; ++i) {
-  //   auto w2_i = alpha / (Finf.f[i] * Fzero.g[i] - Fzero.f[i] * Finf.g[i]);
-  //   auto w2_p = alpha / w2;
-  //   invW2[i] = (1.0 * w2_i + 5.0 * w2_p) / 6.0;
-  // }
+  // Fa(r) = (alpha/w2) * [ Finf(r) * Int_0^r Fzero.S + Fzero(r) * Int_r^inf
+  // Finf.S ], where (eg) Fzero.S = Fzero.f*S.f + Fzero.g*S.g.
+  // Trapezoid rule, as in NumCalc::additivePIntegral, but both components
+  // done together: only two (cumulative) integrals
 
-  // save typing:
   const auto &gr = *Fa.rgrid;
-  constexpr auto ztr = NumCalc::zero_to_r;
-  constexpr auto rti = NumCalc::r_to_inf;
+  const auto &drdu = gr.drdu;
+  const auto size = gr.num_points;
+  const auto pinf = (Finf.pinf == 0 || Finf.pinf >= size) ? size : Finf.pinf;
+  const auto max = pinf - 1;
+  const auto c = alpha * gr.du / Wronskian(Finf, Fzero);
 
-  Fa.pinf = gr.num_points;
-  Fa *= 0.0;
-  Fa.pinf = Finf.pinf;
+  const auto R0 = [&](std::size_t i) {
+    return (Fzero.f[i] * Sr.f[i] + Fzero.g[i] * Sr.g[i]) * drdu[i];
+  };
+  const auto Ri = [&](std::size_t i) {
+    return (Finf.f[i] * Sr.f[i] + Finf.g[i] * Sr.g[i]) * drdu[i];
+  };
 
-  NumCalc::additivePIntegral<ztr>(Fa.f, Finf.f, Fzero.f, Sr.f, gr, Finf.pinf);
-  NumCalc::additivePIntegral<ztr>(Fa.f, Finf.f, Fzero.g, Sr.g, gr, Finf.pinf);
-  NumCalc::additivePIntegral<rti>(Fa.f, Fzero.f, Finf.f, Sr.f, gr, Finf.pinf);
-  NumCalc::additivePIntegral<rti>(Fa.f, Fzero.f, Finf.g, Sr.g, gr, Finf.pinf);
-  NumCalc::additivePIntegral<ztr>(Fa.g, Finf.g, Fzero.f, Sr.f, gr, Finf.pinf);
-  NumCalc::additivePIntegral<ztr>(Fa.g, Finf.g, Fzero.g, Sr.g, gr, Finf.pinf);
-  NumCalc::additivePIntegral<rti>(Fa.g, Fzero.g, Finf.f, Sr.f, gr, Finf.pinf);
-  NumCalc::additivePIntegral<rti>(Fa.g, Fzero.g, Finf.g, Sr.g, gr, Finf.pinf);
-  Fa *= (alpha / w2);
+  // r -> infinity part (backwards)
+  double x = 0.0;
+  Fa.f[max] = 0.0;
+  Fa.g[max] = 0.0;
+  for (auto i = max; i-- > 0;) {
+    x += 0.5 * (Ri(i + 1) + Ri(i));
+    if (i == 0 && max > 0)
+      x += 0.5 * Ri(0);
+    Fa.f[i] = c * Fzero.f[i] * x;
+    Fa.g[i] = c * Fzero.g[i] * x;
+  }
+
+  // zero to r part (forwards)
+  auto R0_prev = R0(0);
+  x = max > 0 ? 0.5 * R0_prev : 0.0;
+  Fa.f[0] += c * Finf.f[0] * x;
+  Fa.g[0] += c * Finf.g[0] * x;
+  for (std::size_t i = 1; i <= max; ++i) {
+    const auto R0_i = R0(i);
+    x += 0.5 * (R0_prev + R0_i);
+    R0_prev = R0_i;
+    Fa.f[i] += c * Finf.f[i] * x;
+    Fa.g[i] += c * Finf.g[i] * x;
+  }
 
-  // const auto R0 =
-  //     qip::add(qip::multiply(Fzero.f, Sr.f), qip::multiply(Fzero.g, Sr.g));
-  // const auto Ri =
-  //     qip::add(qip::multiply(Finf.f, Sr.f), qip::multiply(Finf.g, Sr.g));
-  // NumCalc::additivePIntegral<ztr>(Fa.f, Finf.f, R0, gr, Finf.pinf);
-  // NumCalc::additivePIntegral<rti>(Fa.f, Fzero.f, Ri, gr, Finf.pinf);
-  // NumCalc::additivePIntegral<ztr>(Fa.g, Finf.g, R0, gr, Finf.pinf);
-  // NumCalc::additivePIntegral<rti>(Fa.g, Fzero.g, Ri, gr, Finf.pinf);
-  // Fa *= (alpha / w2);
+  for (auto i = pinf; i < size; ++i) {
+    Fa.f[i] = 0.0;
+    Fa.g[i] = 0.0;
+  }
+  Fa.pinf = pinf;
 }
 
 } // namespace Adams
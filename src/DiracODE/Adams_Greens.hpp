@@ -4,9 +4,13 @@ class DiracSpinor;
 namespace DiracODE {
 namespace Adams {
 
+//! Solves (H_0 + v - en)Fa = Sr, given homogeneous solutions Finf, Fzero
 void GreenSolution(DiracSpinor &Fa, const DiracSpinor &Finf,
                    const DiracSpinor &Fzero, const double alpha,
                    const DiracSpinor &Sr);
 
+//! Wronskian of homogeneous solutions: (Finf.f*Fzero.g - Fzero.f*Finf.g)
+double Wronskian(const DiracSpinor &Finf, const DiracSpinor &Fzero);
+
 } // namespace Adams
 } // namespace DiracODE
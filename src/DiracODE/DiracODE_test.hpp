@@ -10,6 +10,7 @@
 #include "qip/Check.hpp"
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <memory>
 #include <numeric>
 #include <string>
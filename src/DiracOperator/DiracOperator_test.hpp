@@ -0,0 +1,85 @@
+#pragma once
+#include "DiracOperator/Operators.hpp"
+#include "Maths/Grid.hpp"
+#include "Physics/PhysConst_constants.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include "qip/Check.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace UnitTest {
+
+//******************************************************************************
+//! Unit tests for Dirac operators: matrix of reduced MEs (batched) vs.
+//! one-by-one reducedME(), for every operator. nb: operators that override
+//! radial_rhs() must also override reducedME_matrix(); this checks that.
+bool DiracOperators(std::ostream &obuff) {
+  bool pass = true;
+
+  const double Zeff = 5.0;
+  const auto grid = std::make_shared<const Grid>(1.0e-7, 100.0, 2000ul,
+                                                 GridType::loglinear, 10.0);
+
+  // Exact H-like orbitals, up to n=5, l=3
+  std::vector<DiracSpinor> orbitals;
+  for (int n = 1; n <= 5; ++n) {
+    for (int l = 0; l < n && l <= 3; ++l) {
+      for (const auto kappa : {l, -l - 1}) {
+        if (kappa != 0)
+          orbitals.push_back(
+              DiracSpinor::exactHlike(n, kappa, grid, Zeff, PhysConst::alpha));
+      }
+    }
+  }
+
+  // Some radial functions (for QED operators)
+  std::vector<double> v_el, v_mag;
+  for (const auto r : grid->r) {
+    v_el.push_back(std::exp(-r) / (1.0 + r));
+    v_mag.push_back(r * std::exp(-2.0 * r));
+  }
+  const auto rN = 5.0 / PhysConst::aB_fm;
+
+  const auto e1 = DiracOperator::E1(*grid);
+  const auto e2 = DiracOperator::Ek(*grid, 2);
+  const auto e1v = DiracOperator::E1_vform(PhysConst::alpha, 0.1);
+  const auto m1 = DiracOperator::M1(*grid, PhysConst::alpha, 0.1);
+  const auto hfsA = DiracOperator::HyperfineA(1.0, 0.5, rN, *grid);
+  const auto hfsK = DiracOperator::HyperfineK(2, 1.0, rN, *grid);
+  const auto pnc = DiracOperator::PNCnsi(5.0, 2.3, *grid);
+  const auto hrad_el = DiracOperator::Hrad_el(v_el);
+  const auto hrad_mag = DiracOperator::Hrad_mag(v_mag);
+  const auto hrad = DiracOperator::Hrad(v_el, v_mag);
+  const auto vertex = DiracOperator::VertexQED(&hfsA, *grid);
+  const auto mlvp = DiracOperator::MLVP(&hfsA, *grid, rN);
+  const auto rinv = DiracOperator::RadialF(*grid, -2);
+  const auto scalar = DiracOperator::ScalarOperator(v_el);
+  const auto null = DiracOperator::NullOperator();
+
+  const std::vector<const DiracOperator::TensorOperator *> hs{
+      &e1, &e2, &e1v, &m1, &hfsA, &hfsK, &pnc, &hrad_el, &hrad_mag, &hrad,
+      &vertex, &mlvp, &rinv, &scalar, &null};
+
+  for (const auto h : hs) {
+    const auto me = h->reducedME_matrix(orbitals, orbitals);
+    double max_diff = 0.0, max_me = 0.0;
+    for (auto i = 0ul; i < orbitals.size(); ++i) {
+      for (auto j = 0ul; j < orbitals.size(); ++j) {
+        const auto me_ij = h->reducedME(orbitals[i], orbitals[j]);
+        max_diff = std::max(max_diff, std::abs(me[i][j] - me_ij));
+        max_me = std::max(max_me, std::abs(me_ij));
+      }
+    }
+    // nb: NullOperator: all zero
+    const auto eps = max_me == 0.0 ? max_diff : max_diff / max_me;
+    pass &= qip::check_value(&obuff, "reducedME_matrix " + h->name(), eps, 0.0,
+                             1.0e-13);
+  }
+
+  return pass;
+}
+
+} // namespace UnitTest
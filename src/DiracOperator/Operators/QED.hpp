@@ -42,6 +42,19 @@ public:
     return Vel.radial_rhs(kappa_a, Fb) + Vm.radial_rhs(kappa_a, Fb);
   }
 
+  virtual std::vector<std::vector<double>>
+  reducedME_matrix(const std::vector<DiracSpinor> &Fas,
+                   const std::vector<DiracSpinor> &Fbs) const override final {
+    auto me = Vel.reducedME_matrix(Fas, Fbs);
+    const auto me_mag = Vm.reducedME_matrix(Fas, Fbs);
+    for (auto i = 0ul; i < me.size(); ++i) {
+      for (auto j = 0ul; j < me[i].size(); ++j) {
+        me[i][j] += me_mag[i][j];
+      }
+    }
+    return me;
+  }
+
 private:
   Hrad_el Vel;
   Hrad_mag Vm;
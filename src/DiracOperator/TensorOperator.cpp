@@ -1,12 +1,17 @@
 #include "DiracOperator/TensorOperator.hpp"
 #include "Angular/Angular_369j.hpp"
+#include "IO/SafeProfiler.hpp"
+#include "Maths/Grid.hpp"
 #include "Maths/NumCalc_quadIntegrate.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
 #include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <gsl/gsl_blas.h>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace DiracOperator {
@@ -161,6 +166,148 @@ double TensorOperator::radialIntegral(const DiracSpinor &Fa,
   // return m_constant * radint * gr.du;
 }
 
+//******************************************************************************
+std::vector<std::vector<double>>
+TensorOperator::reducedME_matrix(const std::vector<DiracSpinor> &Fas,
+                                 const std::vector<DiracSpinor> &Fbs) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
+  std::vector<std::vector<double>> me(Fas.size(),
+                                      std::vector<double>(Fbs.size(), 0.0));
+  if (Fas.empty() || Fbs.empty())
+    return me;
+
+  const auto &gr = *(Fbs.front().rgrid);
+  const auto num_points = gr.num_points;
+  const auto ld = 2 * num_points; // length of each row: [f, g]
+
+  // Integration weights (identical to NumCalc::integrate), including c and v
+  std::vector<double> w(num_points);
+  {
+    using namespace NumCalc;
+    assert(num_points > 2 * Nquad);
+    for (auto i = 0ul; i < num_points; ++i) {
+      const auto c = i < Nquad                ? cq[i] * dq_inv
+                     : i >= num_points - Nquad ? cq[num_points - i - 1] * dq_inv
+                                               : 1.0;
+      const auto v = m_vec.empty() ? 1.0 : m_vec[i];
+      w[i] = m_constant * v * c * gr.drdu[i] * gr.du;
+    }
+  }
+
+  // Indices of orbitals, grouped by kappa
+  using KappaGroup = std::pair<int, std::vector<std::size_t>>;
+  const auto group_by_kappa = [](const std::vector<DiracSpinor> &orbs) {
+    std::vector<KappaGroup> groups;
+    for (auto i = 0ul; i < orbs.size(); ++i) {
+      const auto kappa = orbs[i].k;
+      auto g = std::find_if(begin(groups), end(groups), [kappa](const auto &x) {
+        return x.first == kappa;
+      });
+      if (g == end(groups))
+        groups.push_back({kappa, {i}});
+      else
+        g->second.push_back(i);
+    }
+    return groups;
+  };
+  const auto a_groups = group_by_kappa(Fas);
+  const auto b_groups = group_by_kappa(Fbs);
+
+  // List of (ka, kb) blocks that are not zero by symmetry
+  std::vector<std::pair<std::size_t, std::size_t>> blocks;
+  for (auto ia = 0ul; ia < a_groups.size(); ++ia) {
+    for (auto ib = 0ul; ib < b_groups.size(); ++ib) {
+      if (!isZero(a_groups[ia].first, b_groups[ib].first))
+        blocks.emplace_back(ia, ib);
+    }
+  }
+  if (blocks.empty())
+    return me;
+
+  // Rows [f, g] of each orbital, zero outside [p0, pinf)
+  const auto fill_row = [num_points](double *row, const DiracSpinor &F,
+                                     const std::vector<double> &f,
+                                     const std::vector<double> &g) {
+    const auto pinf = std::min(F.pinf, num_points);
+    std::copy(cbegin(f) + long(F.p0), cbegin(f) + long(pinf), row + F.p0);
+    std::copy(cbegin(g) + long(F.p0), cbegin(g) + long(pinf),
+              row + num_points + F.p0);
+  };
+
+  // A: rows of each kappa group of Fas, contiguous
+  std::vector<std::vector<double>> A(a_groups.size());
+  for (auto ia = 0ul; ia < a_groups.size(); ++ia) {
+    const auto &index = a_groups[ia].second;
+    A[ia].resize(index.size() * ld, 0.0);
+    for (auto i = 0ul; i < index.size(); ++i) {
+      const auto &Fa = Fas[index[i]];
+      fill_row(A[ia].data() + i * ld, Fa, Fa.f, Fa.g);
+    }
+  }
+
+  // w * d^n(Fb)/dr^n: derivatives only calculated once per orbital
+  std::vector<double> dFb(Fbs.size() * ld, 0.0);
+#pragma omp parallel for
+  for (auto j = 0ul; j < Fbs.size(); ++j) {
+    const auto &Fb = Fbs[j];
+    auto *row = dFb.data() + j * ld;
+    if (diff_order == 0) {
+      fill_row(row, Fb, Fb.f, Fb.g);
+    } else {
+      fill_row(row, Fb, NumCalc::derivative(Fb.f, gr.drdu, gr.du, diff_order),
+               NumCalc::derivative(Fb.g, gr.drdu, gr.du, diff_order));
+    }
+    for (auto i = 0ul; i < num_points; ++i) {
+      row[i] *= w[i];
+      row[i + num_points] *= w[i];
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic)
+  for (auto ib = 0ul; ib < blocks.size(); ++ib) {
+    const auto &[ka, a_index] = a_groups[blocks[ib].first];
+    const auto &[kb, b_index] = b_groups[blocks[ib].second];
+    const auto na = a_index.size();
+    const auto nb = b_index.size();
+
+    const auto cff = angularCff(ka, kb);
+    const auto cgg = angularCgg(ka, kb);
+    const auto cfg = angularCfg(ka, kb);
+    const auto cgf = angularCgf(ka, kb);
+
+    // B: rows [Cff*f_b' + Cfg*g_b', Cgf*f_b' + Cgg*g_b'] (w included)
+    std::vector<double> B(nb * ld);
+    for (auto j = 0ul; j < nb; ++j) {
+      const auto *df = dFb.data() + b_index[j] * ld;
+      const auto *dg = df + num_points;
+      auto *bf = B.data() + j * ld;
+      auto *bg = bf + num_points;
+      for (auto i = 0ul; i < num_points; ++i) {
+        bf[i] = cff * df[i] + cfg * dg[i];
+        bg[i] = cgf * df[i] + cgg * dg[i];
+      }
+    }
+
+    // R = A.B^T (na x nb)
+    std::vector<double> R(na * nb);
+    auto Am = gsl_matrix_view_array(A[blocks[ib].first].data(), na, ld);
+    auto Bm = gsl_matrix_view_array(B.data(), nb, ld);
+    auto Rm = gsl_matrix_view_array(R.data(), na, nb);
+    gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, &Am.matrix, &Bm.matrix, 0.0,
+                   &Rm.matrix);
+
+    const auto F_ab = angularF(ka, kb);
+    for (auto i = 0ul; i < na; ++i) {
+      for (auto j = 0ul; j < nb; ++j) {
+        me[a_index[i]][b_index[j]] = F_ab * R[i * nb + j];
+      }
+    }
+  }
+
+  return me;
+}
+
 //******************************************************************************
 //******************************************************************************
 //******************************************************************************
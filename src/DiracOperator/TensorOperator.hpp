@@ -149,6 +149,22 @@ public:
   //! Defined via <a||h||b> = angularF(a,b) * radialIntegral(a,b)
   double radialIntegral(const DiracSpinor &Fa, const DiracSpinor &Fb) const;
   double reducedME(const DiracSpinor &Fa, const DiracSpinor &Fb) const;
+
+  //! Matrix of reduced MEs: me[i][j] = <a_i||h||b_j>, for all a in Fas, b in
+  //! Fbs. Same as reducedME() for each pair, but much faster for large sets
+  /*! @details
+  Orbitals are grouped by kappa; pairs that are zero by symmetry (isZero) are
+  skipped. For each (ka, kb) block, the radial integrals are a single matrix
+  product (gsl_blas_dgemm): R = A.B^T, where rows of A are [f_a, g_a], and rows
+  of B are [w*v*(Cff*f_b' + Cfg*g_b'), w*v*(Cgf*f_b' + Cgg*g_b')], w are the
+  NumCalc::integrate weights, and f_b' is f_b, or its derivative (calculated
+  just once per orbital). All orbitals must be on the same grid. Operators that
+  override radial_rhs() must also override this (checked for each operator in
+  DiracOperator_test.hpp: add new operators there).
+  */
+  virtual std::vector<std::vector<double>>
+  reducedME_matrix(const std::vector<DiracSpinor> &Fas,
+                   const std::vector<DiracSpinor> &Fbs) const;
 };
 
 //****************************************************************************
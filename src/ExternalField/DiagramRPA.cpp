@@ -2,6 +2,7 @@
 #include "Angular/Angular_369j.hpp"
 #include "Angular/Angular_tables.hpp"
 #include "Coulomb/Coulomb.hpp"
+#include "Coulomb/QkTable.hpp"
 #include "Coulomb/YkTable.hpp"
 #include "DiracOperator/TensorOperator.hpp"
 #include "IO/ChronoTimer.hpp"
@@ -161,17 +162,23 @@ void DiagramRPA::fill_W_matrix(const DiracOperator::TensorOperator *const h) {
     return;
   }
 
-  const auto maxtj_c =
-      std::max_element(holes.cbegin(), holes.cend(), DiracSpinor::comp_j)
-          ->twoj();
-  const auto maxtj_e =
-      std::max_element(excited.cbegin(), excited.cend(), DiracSpinor::comp_j)
-          ->twoj();
-  const auto maxtj = std::max(maxtj_c, maxtj_e);
-
-  const Coulomb::YkTable Yhe(holes.front().rgrid, &holes, &excited);
-  const auto &Ck = Yhe.Ck();
-  const Angular::SixJ sj(maxtj);
+  // Tabulate all Q^k integrals with two holes and two excited states (these
+  // are the only ones required), using 8-fold symmetry. Each Q is used many
+  // times below (including in exchange P terms)
+  std::vector<DiracSpinor> orbs = holes;
+  orbs.insert(end(orbs), cbegin(excited), cend(excited));
+  Coulomb::QkTable qk;
+  {
+    // Holes come first in orbs; qk's orbital index is set before select is
+    // called, so this is a constant-time look-up
+    const auto num_holes = [&qk, nh = int(holes.size())](const auto &... Fi) {
+      return (... + int(qk.index(Fi) >= 0 && qk.index(Fi) < nh));
+    };
+    const Coulomb::YkTable Yij(holes.front().rgrid, &orbs);
+    qk.fill(orbs, Yij, -1,
+            [&](const auto &Fa, const auto &Fb, const auto &Fc,
+                const auto &Fd) { return num_holes(Fa, Fb, Fc, Fd) == 2; });
+  }
 
   // RPA: store W Coulomb integrals (used only for Core RPA its)
   std::cout << "Filling RPA Diagram matrix ("
@@ -179,48 +186,31 @@ void DiagramRPA::fill_W_matrix(const DiracOperator::TensorOperator *const h) {
             << DiracSpinor::state_config(excited) << ") .. " << std::flush;
   Wanmb.resize(holes.size());
   Wabmn.resize(holes.size());
-  // First set: only use Yhe and Yee
-  {
-    const Coulomb::YkTable Yee(holes.front().rgrid, &excited);
 #pragma omp parallel for
-    for (std::size_t i = 0; i < holes.size(); i++) {
-      const auto &Fa = holes[i];
-      auto &Wa_nmb = Wanmb[i];
-      auto &Wa_bmn = Wabmn[i];
-      Wa_nmb.reserve(excited.size());
-      Wa_bmn.reserve(excited.size());
-      for (const auto &Fn : excited) {
-        auto &Wan_mb = Wa_nmb.emplace_back();
-        auto &Wab_mn = Wa_bmn.emplace_back();
-        Wan_mb.reserve(excited.size());
-        Wab_mn.reserve(excited.size());
-        for (const auto &Fm : excited) {
-          auto &Wanm_b = Wan_mb.emplace_back();
-          auto &Wabm_n = Wab_mn.emplace_back();
-          Wanm_b.reserve(holes.size());
-          Wabm_n.reserve(holes.size());
-          for (const auto &Fb : holes) {
-            if (h->isZero(Fb.k, Fn.k)) {
-              Wanm_b.emplace_back(0.0);
-              Wabm_n.emplace_back(0.0);
-              continue;
-            }
-            const auto yknb = Yhe.ptr_yk_ab(m_rank, Fb, Fn);
-            const auto &ybm = Yhe.get_y_ab(Fb, Fm);
-            const auto &ynm = Yee.get_y_ab(Fn, Fm);
-            const auto xQ =
-                yknb ? Coulomb::Qk_abcd(Fa, Fn, Fm, Fb, m_rank, *yknb, Ck)
-                     : 0.0;
-            const auto xP =
-                Coulomb::Pk_abcd(Fa, Fn, Fm, Fb, m_rank, ynm, Ck, sj);
-            const auto yQ =
-                yknb ? Coulomb::Qk_abcd(Fa, Fb, Fm, Fn, m_rank, *yknb, Ck)
-                     : 0.0;
-            const auto yP =
-                Coulomb::Pk_abcd(Fa, Fb, Fm, Fn, m_rank, ybm, Ck, sj);
-            Wanm_b.push_back(MyCast<Wtype>(xQ + xP));
-            Wabm_n.push_back(MyCast<Wtype>(yQ + yP));
+  for (std::size_t i = 0; i < holes.size(); i++) {
+    const auto &Fa = holes[i];
+    auto &Wa_nmb = Wanmb[i];
+    auto &Wa_bmn = Wabmn[i];
+    Wa_nmb.reserve(excited.size());
+    Wa_bmn.reserve(excited.size());
+    for (const auto &Fn : excited) {
+      auto &Wan_mb = Wa_nmb.emplace_back();
+      auto &Wab_mn = Wa_bmn.emplace_back();
+      Wan_mb.reserve(excited.size());
+      Wab_mn.reserve(excited.size());
+      for (const auto &Fm : excited) {
+        auto &Wanm_b = Wan_mb.emplace_back();
+        auto &Wabm_n = Wab_mn.emplace_back();
+        Wanm_b.reserve(holes.size());
+        Wabm_n.reserve(holes.size());
+        for (const auto &Fb : holes) {
+          if (h->isZero(Fb.k, Fn.k)) {
+            Wanm_b.emplace_back(0.0);
+            Wabm_n.emplace_back(0.0);
+            continue;
           }
+          Wanm_b.push_back(MyCast<Wtype>(qk.W(m_rank, Fa, Fn, Fm, Fb)));
+          Wabm_n.push_back(MyCast<Wtype>(qk.W(m_rank, Fa, Fb, Fm, Fn)));
         }
       }
     }
@@ -229,48 +219,31 @@ void DiagramRPA::fill_W_matrix(const DiracOperator::TensorOperator *const h) {
   Wmnab.resize(excited.size());
   Wmban.resize(excited.size());
   std::cout << "." << std::flush;
-  {
-    // Only use Yhe and Yhh here:
-    const Coulomb::YkTable Yhh(holes.front().rgrid, &holes);
 #pragma omp parallel for
-    for (std::size_t i = 0; i < excited.size(); i++) {
-      const auto &Fm = excited[i];
-      auto &Wa_nmb = Wmnab[i];
-      auto &Wa_bmn = Wmban[i];
-      Wa_nmb.reserve(excited.size());
-      Wa_bmn.reserve(excited.size());
-      for (const auto &Fn : excited) {
-        auto &Wan_mb = Wa_nmb.emplace_back();
-        auto &Wab_mn = Wa_bmn.emplace_back();
-        Wan_mb.reserve(holes.size());
-        Wab_mn.reserve(holes.size());
-        for (const auto &Fa : holes) {
-          auto &Wanm_b = Wan_mb.emplace_back();
-          auto &Wabm_n = Wab_mn.emplace_back();
-          Wanm_b.reserve(holes.size());
-          Wabm_n.reserve(holes.size());
-          for (const auto &Fb : holes) {
-            if (h->isZero(Fb.k, Fn.k)) {
-              Wanm_b.emplace_back(0.0);
-              Wabm_n.emplace_back(0.0);
-              continue;
-            }
-            const auto yknb = Yhe.ptr_yk_ab(m_rank, Fb, Fn);
-            const auto &yna = Yhe.get_y_ab(Fa, Fn);
-            const auto &yba = Yhh.get_y_ab(Fb, Fa);
-            const auto xQ =
-                yknb ? Coulomb::Qk_abcd(Fm, Fn, Fa, Fb, m_rank, *yknb, Ck)
-                     : 0.0;
-            const auto xP =
-                Coulomb::Pk_abcd(Fm, Fn, Fa, Fb, m_rank, yna, Ck, sj);
-            const auto yQ =
-                yknb ? Coulomb::Qk_abcd(Fm, Fb, Fa, Fn, m_rank, *yknb, Ck)
-                     : 0.0;
-            const auto yP =
-                Coulomb::Pk_abcd(Fm, Fb, Fa, Fn, m_rank, yba, Ck, sj);
-            Wanm_b.push_back(MyCast<Wtype>(xQ + xP));
-            Wabm_n.push_back(MyCast<Wtype>(yQ + yP));
+  for (std::size_t i = 0; i < excited.size(); i++) {
+    const auto &Fm = excited[i];
+    auto &Wa_nmb = Wmnab[i];
+    auto &Wa_bmn = Wmban[i];
+    Wa_nmb.reserve(excited.size());
+    Wa_bmn.reserve(excited.size());
+    for (const auto &Fn : excited) {
+      auto &Wan_mb = Wa_nmb.emplace_back();
+      auto &Wab_mn = Wa_bmn.emplace_back();
+      Wan_mb.reserve(holes.size());
+      Wab_mn.reserve(holes.size());
+      for (const auto &Fa : holes) {
+        auto &Wanm_b = Wan_mb.emplace_back();
+        auto &Wabm_n = Wab_mn.emplace_back();
+        Wanm_b.reserve(holes.size());
+        Wabm_n.reserve(holes.size());
+        for (const auto &Fb : holes) {
+          if (h->isZero(Fb.k, Fn.k)) {
+            Wanm_b.emplace_back(0.0);
+            Wabm_n.emplace_back(0.0);
+            continue;
           }
+          Wanm_b.push_back(MyCast<Wtype>(qk.W(m_rank, Fm, Fn, Fa, Fb)));
+          Wabm_n.push_back(MyCast<Wtype>(qk.W(m_rank, Fm, Fb, Fa, Fn)));
         }
       }
     }
@@ -283,24 +256,9 @@ void DiagramRPA::setup_ts(const DiracOperator::TensorOperator *const h) {
   if (holes.empty() || excited.empty())
     return;
 
-  t0am.clear();
-  t0ma.clear();
-
   // Calc t0 (and setup t)
-  for (const auto &Fa : holes) {
-    std::vector<double> t0a_m;
-    for (const auto &Fm : excited) {
-      t0a_m.push_back(h->reducedME(Fa, Fm));
-    }
-    t0am.push_back(t0a_m);
-  }
-  for (const auto &Fm : excited) {
-    std::vector<double> t0m_a;
-    for (const auto &Fa : holes) {
-      t0m_a.push_back(h->reducedME(Fm, Fa));
-    }
-    t0ma.push_back(t0m_a);
-  }
+  t0am = h->reducedME_matrix(holes, excited);
+  t0ma = h->reducedME_matrix(excited, holes);
   clear();
 }
 //******************************************************************************
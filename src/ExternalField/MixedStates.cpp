@@ -55,6 +55,9 @@ void solveMixedState(DiracSpinor &dF, const DiracSpinor &Fa, const double omega,
   auto dF0 = dF;
 
   for (int its = 0; true; its++) {
+    // Approximate (local) exchange potential, included on both sides of
+    // equation to help convergance. nb: must be updated each iteration; if
+    // formed only from the first (poor) dF, may not converge (e.g., PNC)
     const auto vx = vex_approx(dF, core);
     const auto v = qip::add(vl, vx);
     auto rhs = (vx * dF) - vexFa(dF, core) - hFa;
@@ -242,8 +242,13 @@ void TDHF::solve_core(const double omega, const int max_its, const bool print) {
         const auto vl = p_hf->get_vlocal(Xx.l()); // to include l-dep QED
         ExternalField::solveMixedState(Xx, Fc, omega, vl, m_alpha, m_core, rhs,
                                        eps_ms, nullptr, p_VBr, m_Hmag);
+        // First-order normalisation: <c|X_c> = 0. Not fixed by the equation
+        // in this channel; for k=0 (e.g., delta V_nuc), would change core norm
+        if (Xx.k == Fc.k)
+          Xx -= (Fc * Xx) * Fc;
         Xx = a_damp * oldX + (1.0 - a_damp) * Xx;
-        const auto delta = (Xx - oldX) * (Xx - oldX) / (Xx * Xx);
+        const DiracSpinor dX = Xx - oldX;
+        const auto delta = (dX * dX) / (Xx * Xx);
         if (delta > eps_c)
           eps_c = delta;
       }
@@ -262,6 +267,8 @@ void TDHF::solve_core(const double omega, const int max_its, const bool print) {
           const auto vl = p_hf->get_vlocal(Yx.l());
           ExternalField::solveMixedState(Yx, Fc, -omega, vl, m_alpha, m_core,
                                          rhs, eps_ms, nullptr, p_VBr, m_Hmag);
+          if (Yx.k == Fc.k)
+            Yx -= (Fc * Yx) * Fc;
           Yx = a_damp * oldY + (1.0 - a_damp) * Yx;
         }
       } else {
@@ -309,7 +316,7 @@ void TDHF::solve_core(const double omega, const int max_its, const bool print) {
 double TDHF::dV(const DiracSpinor &Fn, const DiracSpinor &Fm, bool conj,
                 const DiracSpinor *const Fexcl, bool incl_dV) const {
   const auto s = conj && m_h->imaginaryQ() ? -1 : 1; // careful. OK?
-  return s * Fn * dV_rhs(Fn.k, Fm, conj, Fexcl, incl_dV);
+  return s * (Fn * dV_rhs(Fn.k, Fm, conj, Fexcl, incl_dV));
 }
 
 double TDHF::dV(const DiracSpinor &Fn, const DiracSpinor &Fm) const {
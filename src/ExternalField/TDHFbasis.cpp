@@ -186,7 +186,8 @@ void TDHFbasis::solve_core(const double omega, int max_its, const bool print) {
       for (auto beta = 0ul; beta < m_X[ic].size(); beta++) {
         const auto &Xx = tmp_X[ic][beta];
         const auto &oldX = m_X[ic][beta];
-        const auto eps_beta = (Xx - oldX) * (Xx - oldX) / (Xx * Xx);
+        const DiracSpinor dX = Xx - oldX;
+        const auto eps_beta = (dX * dX) / (Xx * Xx);
         if (eps_beta > eps) {
           eps = eps_beta;
         }
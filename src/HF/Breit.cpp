@@ -1,6 +1,5 @@
 #include "HF/Breit.hpp"
 #include "Angular/Angular_369j.hpp"
-#include "Coulomb/Coulomb.hpp"
 #include "Maths/Grid.hpp"
 #include <iostream>
 #include <memory>
@@ -11,8 +10,19 @@ namespace HF {
 // Calculates V_br*Fa = \sum_b\sum_k B^k_ba F_b - For HF potential
 DiracSpinor Breit::VbrFa(const DiracSpinor &Fa) const {
   DiracSpinor BFa(Fa.n, Fa.k, Fa.rgrid); //
-  for (const auto &Fb : *p_core) {
-    BkbaFb(&BFa, Fa, Fb);
+  if (m_scale == 0.0)
+    return BFa;
+
+  // Use stored integrals if Fa (and Fb) are (unchanged) core orbitals
+  const auto ia = m_table.find(Fa);
+  for (auto ib = 0ul; ib < p_core->size(); ++ib) {
+    const auto &Fb = (*p_core)[ib];
+    if (ia && m_table.same(ib, Fb)) {
+      const auto [Bkba, sb] = m_table.get(ib, *ia);
+      BkbaFb(&BFa, Fa, Fb, Bkba, sb);
+    } else {
+      BkbaFb(&BFa, Fa, Fb, hidden::Breit_Bk_ba(Fb, Fa));
+    }
   }
   return BFa;
 }
@@ -20,11 +30,11 @@ DiracSpinor Breit::VbrFa(const DiracSpinor &Fa) const {
 //******************************************************************************
 // Calculates \sum_k B^k_ba F_b - For HF potential
 void Breit::BkbaFb(DiracSpinor *BFb, const DiracSpinor &Fa,
-                   const DiracSpinor &Fb) const {
+                   const DiracSpinor &Fb, const hidden::Breit_Bk_ba &Bkba,
+                   double sb) const {
   if (m_scale == 0.0)
     return;
 
-  const hidden::Breit_Bk_ba Bkba(Fb, Fa); // every k
   const auto ka = Fa.k;
   const auto kb = Fb.k;
 
@@ -36,7 +46,7 @@ void Breit::BkbaFb(DiracSpinor *BFb, const DiracSpinor &Fa,
     // M, O, P
     if (Ckba != 0.0) {
       const auto Ckba2 = Ckba * Ckba / tjap1;
-      MOPk_ij_Fc(BFb, Ckba2, Bkba, k, kb, ka, Fb);
+      MOPk_ij_Fc(BFb, Ckba2, Bkba, k, kb, ka, Fb, sb);
       //
     }
 
@@ -71,8 +81,18 @@ DiracSpinor Breit::dVbrX_Fa(int kappa, int K, const DiracSpinor &Fa,
   // const hidden::Breit_Bk_ba Bkba(Fa, Fb);     // every k
   // const hidden::Breit_Bk_ba BkYBa(Fa, Ybeta); // every k
   // Only create these if at least one angular factor is non-zero
-  std::unique_ptr<hidden::Breit_Bk_ba> Bkba{nullptr};
+  // (Fa, Fb) integrals are stored, if both are core orbitals
+  const hidden::Breit_Bk_ba *Bkba{nullptr};
+  double s_ab = 1.0;
+  std::unique_ptr<hidden::Breit_Bk_ba> Bkba_tmp{nullptr};
   std::unique_ptr<hidden::Breit_Bk_ba> BkYBa{nullptr};
+  if (const auto ia = m_table.find(Fa)) {
+    if (const auto ib = m_table.find(Fb)) {
+      const auto [Bk, sign] = m_table.get(*ia, *ib);
+      Bkba = &Bk;
+      s_ab = sign;
+    }
+  }
 
   const auto kn = dVFa.k;
   const auto ka = Fa.k;
@@ -107,7 +127,8 @@ DiracSpinor Breit::dVbrX_Fa(int kappa, int K, const DiracSpinor &Fa,
     const auto cangY_N = s_Bb * s_Kk * CkaB * Cknb_N * sjY;
 
     if (!Bkba && (cangX != 0.0 || cangX_N != 0.0)) {
-      Bkba = std::make_unique<hidden::Breit_Bk_ba>(Fa, Fb); // every k
+      Bkba_tmp = std::make_unique<hidden::Breit_Bk_ba>(Fa, Fb); // every k
+      Bkba = Bkba_tmp.get();
     }
 
     if (!BkYBa && (cangY != 0.0 || cangY_N != 0.0)) {
@@ -117,7 +138,7 @@ DiracSpinor Breit::dVbrX_Fa(int kappa, int K, const DiracSpinor &Fa,
     }
 
     if (cangX != 0.0)
-      MOPk_ij_Fc(&dVFa, cangX, *Bkba, k, kb, ka, Xbeta);
+      MOPk_ij_Fc(&dVFa, cangX, *Bkba, k, kb, ka, Xbeta, s_ab);
 
     if (cangX_N != 0.0)
       Nk_ij_Fc(&dVFa, cangX_N, *Bkba, k, kb, ka, Xbeta);
@@ -192,23 +213,17 @@ DiracSpinor Breit::dVbrD_Fa(int kappa, int K, const DiracSpinor &Fa,
 //******************************************************************************
 void Breit::MOPk_ij_Fc(DiracSpinor *BFc, const double Cang,
                        const hidden::Breit_Bk_ba &Bkab, int k, int ki, int kj,
-                       const DiracSpinor &Fc) const {
+                       const DiracSpinor &Fc, double sb) const {
   const auto Cc = m_scale * Cang;
   const auto [m1, m2] = Mk(k);
   const auto [o1, o2] = Ok(k);
   const auto p1 = Pk(k);
 
   const auto skp = std::size_t(k + 1);
-  const auto skm = k != 0 ? std::size_t(k - 1) : 0;
-  // nb: when k=0, the 'k-1' vectors are never called
-  const auto &b0p = Bkab.bk_0[skp];
-  const auto &b0m = Bkab.bk_0[skm];
-  const auto &bip = Bkab.bk_inf[skp];
-  const auto &bim = Bkab.bk_inf[skm];
-  const auto &g0p = Bkab.gk_0[skp];
-  const auto &g0m = Bkab.gk_0[skm];
-  const auto &gip = Bkab.gk_inf[skp];
-  const auto &gim = Bkab.gk_inf[skm];
+  const auto &b0p = Bkab.bk_0(skp);
+  const auto &bip = Bkab.bk_inf(skp);
+  const auto &g0p = Bkab.gk_0(skp);
+  const auto &gip = Bkab.gk_inf(skp);
 
   const auto ep = eta(k + 1, ki, kj);
   const auto e = eta(k, ki, kj);
@@ -221,18 +236,27 @@ void Breit::MOPk_ij_Fc(DiracSpinor *BFc, const double Cang,
   // M1 and O1 term:
   if (m1 != 0.0 || o1 != 0.0) {
     for (auto i = Fc.p0; i < Fc.pinf; ++i) {
-      const auto ff =
-          Cc * (m1 + o1) * (b0p[i] + bip[i] + ep * g0p[i] + ep * gip[i]);
+      const auto ff = Cc * (m1 + o1) *
+                      (sb * b0p[i] + sb * bip[i] + ep * g0p[i] + ep * gip[i]);
       BFc->f[i] += ff * (1.0 - ep) * Fc.g[i];
       BFc->g[i] += -ff * (1.0 + ep) * Fc.f[i];
     }
   }
 
+  // nb: when k=0, m2=o2=p1=0, and the 'k-1' vectors don't exist
+  if (k == 0)
+    return;
+  const auto skm = std::size_t(k - 1);
+  const auto &b0m = Bkab.bk_0(skm);
+  const auto &bim = Bkab.bk_inf(skm);
+  const auto &g0m = Bkab.gk_0(skm);
+  const auto &gim = Bkab.gk_inf(skm);
+
   // M2 and O2 term:
   if (m2 != 0.0 || o2 != 0.0) {
     for (auto i = Fc.p0; i < Fc.pinf; ++i) {
-      const auto ff =
-          Cc * (m2 + o2) * (-b0m[i] - bim[i] + e * g0m[i] + e * gim[i]);
+      const auto ff = Cc * (m2 + o2) *
+                      (-sb * b0m[i] - sb * bim[i] + e * g0m[i] + e * gim[i]);
       BFc->f[i] += -ff * (1.0 + e) * Fc.g[i];
       BFc->g[i] += ff * (1.0 - e) * Fc.f[i];
     }
@@ -241,12 +265,14 @@ void Breit::MOPk_ij_Fc(DiracSpinor *BFc, const double Cang,
   // P1 and P2term:
   if (p1 != 0.0) {
     for (auto i = Fc.p0; i < Fc.pinf; ++i) {
-      const auto ff = Cc * p1 * (-b0m[i] + e * g0m[i] + b0p[i] - e * g0p[i]);
+      const auto ff =
+          Cc * p1 * (-sb * b0m[i] + e * g0m[i] + sb * b0p[i] - e * g0p[i]);
       BFc->f[i] += ff * (1.0 - ep) * Fc.g[i];
       BFc->g[i] += -ff * (1.0 + ep) * Fc.f[i];
     }
     for (auto i = Fc.p0; i < Fc.pinf; ++i) {
-      const auto ff = Cc * p1 * (bim[i] + ep * gim[i] - bip[i] - ep * gip[i]);
+      const auto ff =
+          Cc * p1 * (sb * bim[i] + ep * gim[i] - sb * bip[i] - ep * gip[i]);
       BFc->f[i] += -ff * (1.0 + e) * Fc.g[i];
       BFc->g[i] += ff * (1.0 - e) * Fc.f[i];
     }
@@ -264,9 +290,12 @@ void Breit::Nk_ij_Fc(DiracSpinor *BFc, const double Cang,
     BFc->p0 = Fc.p0;
 
   const auto sk = std::size_t(k);
+  // If g^k not allowed by selection rules, it is not stored (it is zero)
+  if (!Bkij.has_gk(sk))
+    return;
   const auto Cg = m_scale * Cang * Nkba(k, ki, kj);
-  const auto &g0 = Bkij.gk_0[sk];
-  const auto &gi = Bkij.gk_inf[sk];
+  const auto &g0 = Bkij.gk_0(sk);
+  const auto &gi = Bkij.gk_inf(sk);
   for (auto i = Fc.p0; i < Fc.pinf; ++i) {
     BFc->f[i] += Cg * (g0[i] + gi[i]) * Fc.g[i];
     BFc->g[i] += Cg * (g0[i] + gi[i]) * Fc.f[i];
@@ -295,45 +324,4 @@ double Breit::Pk(int k) const {
   return double(k * (k + 1)) / double(2 * (2 * k + 1));
 }
 
-//******************************************************************************
-namespace hidden {
-
-Breit_Bk_ba::Breit_Bk_ba(const DiracSpinor &Fb, const DiracSpinor &Fa)
-    : max_k(std::size_t((Fb.twoj() + Fa.twoj()) / 2) + 1) {
-
-  // size vectors according to kmax :
-  bk_0.resize(max_k + 1);
-  bk_inf.resize(max_k + 1);
-  gk_0.resize(max_k + 1);
-  gk_inf.resize(max_k + 1);
-
-  // Fill the b^k functions
-  for (auto k = 0ul; k <= max_k; ++k) {
-    // a) selection rules (careful)
-    // const auto maxi = 0; //
-    const auto maxi = std::max(Fa.pinf, Fb.pinf); // ok?
-    // const auto maxi = std::min(Fa.pinf, Fb.pinf); // XXX OK? No.
-
-    // These normally re-sized in gk_ab()... but not if skip due to SRs
-    bk_0[k].resize(Fa.rgrid->num_points);
-    bk_inf[k].resize(Fa.rgrid->num_points);
-    gk_0[k].resize(Fa.rgrid->num_points);
-    gk_inf[k].resize(Fa.rgrid->num_points);
-
-    // bk, in M,N,O, only used if C^(k+/-1)_ba non-zero
-    if (Angular::Ck_kk_SR(int(k) - 1, Fb.k, Fa.k) ||
-        Angular::Ck_kk_SR(int(k) + 1, Fb.k, Fa.k)) {
-      Coulomb::bk_ab(Fb, Fa, int(k), bk_0[k], bk_inf[k], maxi);
-    }
-    // gk, in M,N,O AND N only used if C^(k+/-1)_ab and C^(k)_(-b,a)
-    if (Angular::Ck_kk_SR(int(k) - 1, Fb.k, Fa.k) ||
-        Angular::Ck_kk_SR(int(k) + 1, Fb.k, Fa.k) ||
-        Angular::Ck_kk_SR(int(k), -Fb.k, Fa.k)) {
-      Coulomb::gk_ab(Fb, Fa, int(k), gk_0[k], gk_inf[k], maxi);
-    }
-  }
-}
-
-} // namespace hidden
-
 } // namespace HF
@@ -1,23 +1,39 @@
 #pragma once
+#include "HF/BreitTable.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
 #include <utility>
 #include <vector>
 
 namespace HF {
 
-namespace hidden {
-struct Breit_Bk_ba; // forward decl
-}
-
 //******************************************************************************
 //! Breit (Hartree-Fock Breit) interaction potential
 class Breit {
 public:
   //! Contains ptr to core: careful if updating core (e.g., in HF)
+  //! @details Breit integrals for each pair of core orbitals are calculated
+  //! on construction, and stored (see BreitTable)
   Breit(const std::vector<DiracSpinor> &in_core, double in_scale = 1.0)
-      : p_core(&in_core), m_scale(in_scale) {}
+      : p_core(&in_core),
+        m_scale(in_scale),
+        m_table(in_scale == 0.0 ? std::vector<DiracSpinor>{} : in_core) {}
   // nb: During HF, must update orbitals each time
 
+  //! Re-calculates stored core Breit integrals, for any core orbitals that
+  //! have changed. (If not called after core changes, the stored integrals are
+  //! simply not used: results are correct, but slower)
+  void update_table() {
+    if (m_scale != 0.0)
+      m_table.update(*p_core);
+  }
+
+  //! Points the Breit operator to (new) core, and updates stored integrals.
+  //! Re-uses the existing table: allows one Breit to outlive a temporary core
+  void update_core(const std::vector<DiracSpinor> &core) {
+    p_core = &core;
+    update_table();
+  }
+
   //! () operator: returns VbrFa(Fa)
   DiracSpinor operator()(const DiracSpinor &Fa) const { return VbrFa(Fa); }
   //! Calculates V_br*Fa = \sum_b\sum_k B^k_ba F_b [Breit part of HF-Breit pot.]
@@ -36,16 +52,20 @@ public:
                        const DiracSpinor &Ybeta) const;
 
 private:
-  const std::vector<DiracSpinor> *const p_core;
+  const std::vector<DiracSpinor> *p_core;
   const double m_scale;
+  // Breit integrals for each pair of core orbitals
+  BreitTable m_table;
 
   // Calculates \sum_k B^k_ba F_b (single core contr. to V_brFa)
-  void BkbaFb(DiracSpinor *BFb, const DiracSpinor &Fa,
-              const DiracSpinor &Fb) const;
+  // Bkba are the Breit integrals for (b,a); sb is sign of the b^k functions
+  void BkbaFb(DiracSpinor *BFb, const DiracSpinor &Fa, const DiracSpinor &Fb,
+              const hidden::Breit_Bk_ba &Bkba, double sb = 1.0) const;
 
+  // nb: sb is sign of the b^k functions (-1 if Bkab is for swapped pair)
   void MOPk_ij_Fc(DiracSpinor *BFc, const double Cang,
                   const hidden::Breit_Bk_ba &Bkab, int k, int ki, int kj,
-                  const DiracSpinor &Fc) const;
+                  const DiracSpinor &Fc, double sb = 1.0) const;
   void Nk_ij_Fc(DiracSpinor *BFc, const double Cang,
                 const hidden::Breit_Bk_ba &Bkij, int k, int ki, int kj,
                 const DiracSpinor &Fc) const;
@@ -63,20 +83,4 @@ public:
   ~Breit() = default;
 };
 
-//******************************************************************************
-namespace hidden {
-
-struct Breit_Bk_ba {
-  // Class to hold the Breit-Coulomb integrals
-public:
-  Breit_Bk_ba(const DiracSpinor &Fb, const DiracSpinor &Fa);
-
-  const std::size_t max_k;
-  std::vector<std::vector<double>> bk_0{};
-  std::vector<std::vector<double>> bk_inf{};
-  std::vector<std::vector<double>> gk_0{};
-  std::vector<std::vector<double>> gk_inf{};
-};
-} // namespace hidden
-
 } // namespace HF
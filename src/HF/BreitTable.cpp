@@ -0,0 +1,112 @@
+#include "HF/BreitTable.hpp"
+#include "Angular/Angular_369j.hpp"
+#include "Coulomb/Coulomb.hpp"
+#include "IO/SafeProfiler.hpp"
+#include "Maths/Grid.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace HF {
+
+//******************************************************************************
+void BreitTable::update(const std::vector<DiracSpinor> &orbs) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
+  const auto num = orbs.size();
+  const bool same_set =
+      num == m_orbs.size() &&
+      std::equal(cbegin(orbs), cend(orbs), cbegin(m_orbs)); // n, kappa only
+
+  // Which orbitals have changed:
+  std::vector<bool> changed(num, true);
+  if (same_set) {
+    for (auto i = 0ul; i < num; ++i) {
+      changed[i] = !same(i, orbs[i]);
+      if (changed[i])
+        m_orbs[i] = orbs[i];
+    }
+  } else {
+    m_orbs.clear();
+    m_orbs = orbs;
+    m_Bk.clear();
+    m_Bk.resize(num * (num + 1) / 2);
+  }
+
+  // List of pairs to (re)calculate
+  std::vector<std::pair<std::size_t, std::size_t>> todo;
+  for (auto j = 0ul; j < num; ++j) {
+    for (auto i = 0ul; i <= j; ++i) {
+      if (changed[i] || changed[j])
+        todo.emplace_back(i, j);
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic)
+  for (auto ip = 0ul; ip < todo.size(); ++ip) {
+    const auto [i, j] = todo[ip];
+    m_Bk[index(i, j)] = hidden::Breit_Bk_ba(m_orbs[i], m_orbs[j]);
+  }
+}
+
+//******************************************************************************
+bool BreitTable::same(std::size_t i, const DiracSpinor &Fa) const {
+  if (i >= m_orbs.size())
+    return false;
+  const auto &Fi = m_orbs[i];
+  return Fi == Fa && Fi.p0 == Fa.p0 && Fi.pinf == Fa.pinf && Fi.f == Fa.f &&
+         Fi.g == Fa.g;
+}
+
+//------------------------------------------------------------------------------
+std::optional<std::size_t> BreitTable::find(const DiracSpinor &Fa) const {
+  for (auto i = 0ul; i < m_orbs.size(); ++i) {
+    if (m_orbs[i] == Fa)
+      return same(i, Fa) ? std::optional<std::size_t>{i} : std::nullopt;
+  }
+  return std::nullopt;
+}
+
+//******************************************************************************
+namespace hidden {
+
+Breit_Bk_ba::Breit_Bk_ba(const DiracSpinor &Fb, const DiracSpinor &Fa)
+    : max_k(std::size_t((Fb.twoj() + Fa.twoj()) / 2) + 1) {
+
+  // size index vectors according to kmax :
+  m_b_index.resize(max_k + 1, -1);
+  m_g_index.resize(max_k + 1, -1);
+
+  // a) selection rules (careful)
+  // const auto maxi = 0; //
+  const auto maxi = std::max(Fa.pinf, Fb.pinf); // ok?
+  // const auto maxi = std::min(Fa.pinf, Fb.pinf); // XXX OK? No.
+
+  // Fill the b^k functions: only store those allowed by selection rules
+  for (auto k = 0ul; k <= max_k; ++k) {
+    // bk, in M,N,O, only used if C^(k+/-1)_ba non-zero
+    const auto bk_SR = Angular::Ck_kk_SR(int(k) - 1, Fb.k, Fa.k) ||
+                       Angular::Ck_kk_SR(int(k) + 1, Fb.k, Fa.k);
+    // gk, in M,N,O AND N only used if C^(k+/-1)_ab and C^(k)_(-b,a)
+    const auto gk_SR = bk_SR || Angular::Ck_kk_SR(int(k), -Fb.k, Fa.k);
+
+    if (bk_SR) {
+      m_b_index[k] = int(m_bk_0.size());
+      auto &b0 = m_bk_0.emplace_back();
+      auto &binf = m_bk_inf.emplace_back();
+      Coulomb::bk_ab(Fb, Fa, int(k), b0, binf, maxi);
+    }
+    if (gk_SR) {
+      m_g_index[k] = int(m_gk_0.size());
+      auto &g0 = m_gk_0.emplace_back();
+      auto &ginf = m_gk_inf.emplace_back();
+      Coulomb::gk_ab(Fb, Fa, int(k), g0, ginf, maxi);
+    }
+  }
+}
+
+} // namespace hidden
+
+} // namespace HF
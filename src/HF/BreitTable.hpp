@@ -0,0 +1,110 @@
+#pragma once
+#include "Wavefunction/DiracSpinor.hpp"
+#include <cassert>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace HF {
+
+//******************************************************************************
+namespace hidden {
+
+struct Breit_Bk_ba {
+  // Class to hold the Breit-Coulomb integrals
+  // Only those k allowed by selection rules are stored (others are never used)
+public:
+  Breit_Bk_ba() = default;
+  Breit_Bk_ba(const DiracSpinor &Fb, const DiracSpinor &Fa);
+
+  std::size_t max_k{0};
+
+  // b^k (0 and inf parts); k must be allowed: C^(k-1)_ba or C^(k+1)_ba != 0
+  const std::vector<double> &bk_0(std::size_t k) const {
+    return m_bk_0[b_index(k)];
+  }
+  const std::vector<double> &bk_inf(std::size_t k) const {
+    return m_bk_inf[b_index(k)];
+  }
+  // g^k (0 and inf parts); k must be allowed: as b^k, or C^k_(-b)a != 0
+  const std::vector<double> &gk_0(std::size_t k) const {
+    return m_gk_0[g_index(k)];
+  }
+  const std::vector<double> &gk_inf(std::size_t k) const {
+    return m_gk_inf[g_index(k)];
+  }
+  // Checks if g^k is stored (i.e., allowed by the selection rules)
+  bool has_gk(std::size_t k) const {
+    return k < m_g_index.size() && m_g_index[k] >= 0;
+  }
+
+private:
+  // Index (in below lists) for each k (-1 if not allowed)
+  std::vector<int> m_b_index{}, m_g_index{};
+  std::vector<std::vector<double>> m_bk_0{};
+  std::vector<std::vector<double>> m_bk_inf{};
+  std::vector<std::vector<double>> m_gk_0{};
+  std::vector<std::vector<double>> m_gk_inf{};
+
+  std::size_t b_index(std::size_t k) const {
+    assert(k < m_b_index.size() && m_b_index[k] >= 0);
+    return std::size_t(m_b_index[k]);
+  }
+  std::size_t g_index(std::size_t k) const {
+    assert(k < m_g_index.size() && m_g_index[k] >= 0);
+    return std::size_t(m_g_index[k]);
+  }
+};
+} // namespace hidden
+
+//******************************************************************************
+//! Calculates + stores Breit b^k and g^k radial functions (allowed k) for each
+//! pair of orbitals in a set (e.g., core)
+/*! @details
+Analogous to Coulomb::YkTable, but for the Breit radial integrals used by
+HF::Breit. Only pairs with i<=j are stored: b^k is anti-symmetric
+(b^k_ij = -b^k_ji), and g^k symmetric.
+
+The table keeps its own copy of the orbitals it was formed from. update()
+re-calculates only the pairs involving orbitals that have changed since.
+Look-up is by value: find() only returns an index if the given orbital is
+identical (n, kappa, f, g) to a table orbital, so the table is never used for
+an orbital it wasn't formed from (those must be calculated from scratch).
+*/
+class BreitTable {
+public:
+  BreitTable(const std::vector<DiracSpinor> &orbs) { update(orbs); }
+
+  //! Re-calculates integrals for any pairs involving orbitals that have
+  //! changed (all, if orbitals were added/removed)
+  void update(const std::vector<DiracSpinor> &orbs);
+
+  std::size_t size() const { return m_orbs.size(); }
+
+  //! Index of Fa in table, if Fa is identical to a table orbital
+  std::optional<std::size_t> find(const DiracSpinor &Fa) const;
+
+  //! True if i-th table orbital is identical to Fa
+  bool same(std::size_t i, const DiracSpinor &Fa) const;
+
+  //! Integrals for pair (i,j), as hidden::Breit_Bk_ba(Fi, Fj): returns
+  //! {integrals, sign}; b^k functions must be multiplied by sign
+  std::pair<const hidden::Breit_Bk_ba &, double> get(std::size_t i,
+                                                     std::size_t j) const {
+    return i <= j ? std::pair<const hidden::Breit_Bk_ba &, double>{
+                        m_Bk[index(i, j)], 1.0}
+                  : std::pair<const hidden::Breit_Bk_ba &, double>{
+                        m_Bk[index(j, i)], -1.0};
+  }
+
+private:
+  std::vector<DiracSpinor> m_orbs{};
+  // Packed (upper triangle) storage, for pairs i<=j
+  std::vector<hidden::Breit_Bk_ba> m_Bk{};
+
+  static std::size_t index(std::size_t i, std::size_t j) {
+    return j * (j + 1) / 2 + i;
+  }
+};
+
+} // namespace HF
@@ -78,7 +78,7 @@ HartreeFock::HartreeFock(Wavefunction *wf, Method method, double x_Breit,
                   method, x_Breit, eps) {}
 
 //******************************************************************************
-const std::vector<double> &HartreeFock::solveCore() {
+const std::vector<double> &HartreeFock::solveCore(bool warm_start) {
 
   // Core orbs must already be solutions... this OK?
 
@@ -87,6 +87,11 @@ const std::vector<double> &HartreeFock::solveCore() {
 
   switch (m_method) {
   case Method::HartreeFock:
+    if (warm_start) {
+      // vdir from (existing) core, so not damped towards zero initially
+      m_Yab.update_y_ints();
+      form_vdir(m_vdir, false);
+    }
     hf_core_approx(m_eps_HF);
     hf_core_refine();
     break;
@@ -105,10 +110,28 @@ const std::vector<double> &HartreeFock::solveCore() {
 
   // Frozen core Breit:
   // Once core HF done, core "Frozen", Breit operator created
-  // (Temporary VBr used in HF routine)
-  if (m_include_Breit)
-    m_VBr = std::make_unique<HF::Breit>(*p_core, m_x_Breit);
+  // (Re-uses VBr from HF routine, if it exists: only changed integrals updated)
+  if (m_include_Breit) {
+    if (m_VBr)
+      m_VBr->update_core(*p_core);
+    else
+      m_VBr = std::make_unique<HF::Breit>(*p_core, m_x_Breit);
+  }
+
+  return m_vdir;
+}
 
+//******************************************************************************
+const std::vector<double> &
+HartreeFock::setCore(const std::vector<double> &vdir) {
+  m_vdir = vdir;
+  m_Yab.update_y_ints();
+  if (m_include_Breit) {
+    if (m_VBr)
+      m_VBr->update_core(*p_core);
+    else
+      m_VBr = std::make_unique<HF::Breit>(*p_core, m_x_Breit);
+  }
   return m_vdir;
 }
 
@@ -1127,6 +1150,17 @@ inline void HartreeFock::hf_core_refine() {
     vexF_list.push_back(DiracSpinor(Fa.n, Fa.k, Fa.rgrid));
   }
 
+  // Temporary Breit operator (with 'static' core [frozen single iteration]).
+  // Core Breit integrals are stored, and updated each iteration.
+  // Re-uses existing Breit (if exists); moved back into m_VBr at end
+  auto VBr = std::move(m_VBr);
+  if (m_include_Breit) {
+    if (VBr)
+      VBr->update_core(core_prev);
+    else
+      VBr = std::make_unique<HF::Breit>(core_prev, m_x_Breit);
+  }
+
   double eps = 0.0;
   double best_eps = 1.0;
   double best_worst_eps = 1.0;
@@ -1150,11 +1184,8 @@ inline void HartreeFock::hf_core_refine() {
     }
 
     core_prev = (*p_core);
-
-    // Temporary Breit operator (with 'static' core [frozen single iteration])
-    const std::unique_ptr VBr =
-        m_include_Breit ? std::make_unique<HF::Breit>(core_prev, m_x_Breit)
-                        : nullptr;
+    if (VBr)
+      VBr->update_table();
 
 #pragma omp parallel for
     for (std::size_t i = 0; i < num_core_states; ++i) {
@@ -1229,6 +1260,12 @@ inline void HartreeFock::hf_core_refine() {
     form_vdir(m_vdir);
   }
 
+  // core_prev is local: point Breit to the (final) core before storing
+  if (VBr) {
+    VBr->update_core(*p_core);
+    m_VBr = std::move(VBr);
+  }
+
   if (verbose)
     printf("HF core:  it:%3i eps=%6.1e for %s  [%6.1e for %s]\n", //
            it, eps, (*p_core)[worst_index].symbol().c_str(), best_eps,
@@ -103,7 +103,15 @@ public:
               double x_Breit = 0.0, double eps_HF = 0.0);
 
   //! Solves HF equations self-consitantly for core orbs. Produces Vdir
-  const std::vector<double> &solveCore();
+  //! @details If warm_start is true, the core orbitals should already be close
+  //! to the HF solutions (e.g., those of a nearby isotope): Vdir is formed
+  //! from them, and used as the starting point (instead of zero). Only used
+  //! for Method::HartreeFock.
+  const std::vector<double> &solveCore(bool warm_start = false);
+
+  //! For when core orbitals are already HF solutions (e.g., read from file):
+  //! sets Vdir (and updates internal tables + Breit). Does not solve HF.
+  const std::vector<double> &setCore(const std::vector<double> &vdir);
 
   //! @brief Solves HF for valence list; valence states must already be present
   //! in WaveFunction (bad, instead, give it a vector of DiracSpinors!)
@@ -172,7 +180,7 @@ private:
   std::vector<double> m_vdir;
   Coulomb::YkTable m_Yab;
   const bool m_excludeExchange; // XXX Kill this. Only HF,H,aHF
-  std::unique_ptr<const HF::Breit> m_VBr{nullptr};
+  std::unique_ptr<HF::Breit> m_VBr{nullptr};
 
   const int m_max_hf_its = 99;
 
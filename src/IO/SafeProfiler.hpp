@@ -1,8 +1,14 @@
 #pragma once
+#include <algorithm>
+#include <array>
 #include <chrono>
-// #include <filesystem> // needs gcc >8
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,6 +21,20 @@
 //!  - [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
 //!
 //! #include "IO/SafeProfiler.hpp"
+//!
+//! Each thread records into its own buffer (no locks/critical sections, except
+//! once per thread, the first time it profiles anything), so profiling does
+//! not serialise parallel regions. Scopes are recorded as a call tree (each
+//! scope is a child of the enclosing profiled scope on the same thread), with
+//! count, total, min, max and mean times. Nesting is per-thread: scopes run by
+//! worker threads inside a parallel region appear at the top of the tree.
+//!
+//! At program exit, the results (merged over threads) are printed, and written
+//! to (N is first unused integer):
+//!  - ProfileLog_N.txt: flat summary, and call tree
+//!  - ProfileLog_N.csv: flat summary, one line per function
+//!  - ProfileLog_N.json: Chrome trace (open in chrome://tracing, or Perfetto);
+//!    only the first max_trace_events events of each thread are kept
 namespace IO::Profile {
 
 #ifdef IOPROFILER
@@ -23,97 +43,263 @@ constexpr bool do_profile = true;
 constexpr bool do_profile = false;
 #endif
 
-struct StrDoubleUnsigned {
-  StrDoubleUnsigned(std::string is, double id, unsigned iu)
-      : s(std::move(is)), d(id), u(iu) {}
-  std::string s;
-  double d;
-  unsigned u;
+//! Maximum number of (individual) events stored per thread for trace output.
+//! Statistics always include every event.
+constexpr std::size_t max_trace_events = 1000000;
+
+namespace detail {
+
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------------
+// Timing statistics (in ns)
+struct Stats {
+  std::uint64_t count{0};
+  std::int64_t total{0};
+  std::int64_t min{std::numeric_limits<std::int64_t>::max()};
+  std::int64_t max{0};
+
+  void add(std::int64_t t) {
+    ++count;
+    total += t;
+    min = std::min(min, t);
+    max = std::max(max, t);
+  }
+  void add(const Stats &other) {
+    count += other.count;
+    total += other.total;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+  }
+  double mean() const {
+    return count == 0 ? 0.0 : double(total) / double(count);
+  }
 };
 
-//******************************************************************************
-// Thread-safe profiler (timing) tool
-class ProfileLog {
-  friend class Profiler;
-  ProfileLog(){};
-  ~ProfileLog() {
-    if (m_log.empty())
-      return;
-#pragma omp critical(finalise)
-    {
-      for (const auto &le : m_log) {
-        bool new_entry = true;
-        auto each_time = static_cast<double>(le.second.count());
-        for (auto &[name, time, count] : m_log_sorted) {
-          if (name == le.first) {
-            new_entry = false;
-            time += each_time;
-            count++;
-            break;
-          }
-        }
-        if (new_entry)
-          m_log_sorted.emplace_back(le.first, each_time, 1);
-      }
-      write_log();
+//------------------------------------------------------------------------------
+// Node of a call tree. Names are the (static) strings passed to
+// safeProfiler(); only converted to std::string when writing the report
+struct Node {
+  const char *name;
+  const char *extra;
+  std::size_t parent;
+  std::vector<std::size_t> children{};
+  Stats stats{};
+};
+
+// A single timed event (for trace output), times in ns since program start
+struct Event {
+  std::size_t node;
+  std::int64_t start, duration;
+};
+
+//------------------------------------------------------------------------------
+// Per-thread log: only ever accessed by its own thread (until the report)
+struct ThreadLog {
+  explicit ThreadLog(std::size_t in_tid)
+      : tid(in_tid), nodes{Node{"", "", 0}} {}
+  std::size_t tid;
+  std::vector<Node> nodes; // nodes[0] is the root
+  std::size_t current{0};  // currently open scope
+  std::vector<Event> events{};
+
+  // Returns child of current node with given name, creates if needed
+  std::size_t child(const char *name, const char *extra) {
+    for (const auto c : nodes[current].children) {
+      if (nodes[c].name == name && nodes[c].extra == extra)
+        return c;
     }
+    nodes.push_back({name, extra, current});
+    nodes[current].children.push_back(nodes.size() - 1);
+    return nodes.size() - 1;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Owns the log of every thread; writes the report at program exit
+class Registry {
+public:
+  static Registry &get() {
+    static Registry registry;
+    return registry;
+  }
+
+  ThreadLog *new_thread() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_logs.push_back(std::make_unique<ThreadLog>(m_logs.size()));
+    return m_logs.back().get();
+  }
+
+  std::int64_t now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                m_t0)
+        .count();
   }
-  std::vector<std::pair<std::string, std::chrono::microseconds>> m_log = {};
-  std::vector<StrDoubleUnsigned> m_log_sorted = {};
 
-  void write_log() {
+  ~Registry() { report(); }
+
+private:
+  Registry() = default;
+  const Clock::time_point m_t0{Clock::now()};
+  std::mutex m_mutex{};
+  std::vector<std::unique_ptr<ThreadLog>> m_logs{};
+
+  // Call tree, merged over threads (by name)
+  struct MergedNode {
+    std::string name;
+    std::vector<std::size_t> children{};
+    Stats stats{};
+  };
+
+  static std::string node_name(const Node &node) {
+    return std::string(node.extra) == ""
+               ? std::string(node.name)
+               : std::string(node.name) + "_" + std::string(node.extra);
+  }
+
+  static std::string file_name(const std::string &ext) {
     const std::string title = "ProfileLog";
-    auto fname = title + "_0";
-    std::string ext = ".txt";
     auto file_existsQ = [](const std::string &fileName) {
       std::ifstream infile(fileName);
       return infile.good();
     };
-    // std::filesystem::exists(fname + ext) // needs GCC v>8
-    for (int i = 1; file_existsQ(fname + ext); ++i) {
+    // Use first N for which ProfileLog_N.txt doesn't exist
+    auto fname = title + "_0";
+    for (int i = 1; file_existsQ(fname + ".txt"); ++i) {
       fname = title + "_" + std::to_string(i);
     }
-    std::ofstream of(fname + ext);
-    std::cout << "\nProfile:\n";
-    const auto *p_worst = &(m_log_sorted.front());
-    for (const auto &item : m_log_sorted) {
-      const auto &[name, time, count] = item;
-      std::cout << name << " x " << count << " = " << time / 1000.0 << " ms\n";
-      of << name << " x " << count << " = " << time / 1000.0 << " ms\n";
-      if (time >= p_worst->d) {
-        p_worst = &item;
+    return fname + ext;
+  }
+
+  void merge(std::vector<MergedNode> *tree, std::size_t into,
+             const ThreadLog &log, std::size_t from) const {
+    for (const auto c : log.nodes[from].children) {
+      const auto name = node_name(log.nodes[c]);
+      auto &children = (*tree)[into].children;
+      auto it = std::find_if(begin(children), end(children),
+                             [&](auto i) { return (*tree)[i].name == name; });
+      std::size_t m;
+      if (it == end(children)) {
+        tree->push_back({name});
+        m = tree->size() - 1;
+        (*tree)[into].children.push_back(m);
+      } else {
+        m = *it;
+      }
+      (*tree)[m].stats.add(log.nodes[c].stats);
+      merge(tree, m, log, c);
+    }
+  }
+
+  static void write_tree(std::ostream &os, const std::vector<MergedNode> &tree,
+                         std::size_t node, int depth) {
+    auto children = tree[node].children;
+    std::sort(begin(children), end(children), [&](auto a, auto b) {
+      return tree[a].stats.total > tree[b].stats.total;
+    });
+    for (const auto c : children) {
+      const auto &s = tree[c].stats;
+      os << std::string(std::size_t(2 * depth), ' ') << tree[c].name << " x "
+         << s.count << " = " << double(s.total) / 1.0e6 << " ms\n";
+      write_tree(os, tree, c, depth + 1);
+    }
+  }
+
+  void report() const {
+    if (std::all_of(cbegin(m_logs), cend(m_logs),
+                    [](const auto &l) { return l->nodes.size() == 1; }))
+      return;
+
+    std::vector<MergedNode> tree{{"", {}, {}}};
+    for (const auto &log : m_logs)
+      merge(&tree, 0, *log, 0);
+
+    // Flat (by name) statistics, sorted by total time
+    std::map<std::string, Stats> flat_map;
+    for (auto i = 1ul; i < tree.size(); ++i)
+      flat_map[tree[i].name].add(tree[i].stats);
+    std::vector<std::pair<std::string, Stats>> flat(cbegin(flat_map),
+                                                    cend(flat_map));
+    std::sort(begin(flat), end(flat), [](const auto &a, const auto &b) {
+      return a.second.total > b.second.total;
+    });
+
+    const auto txt_name = file_name(".txt");
+    const auto base = txt_name.substr(0, txt_name.size() - 4);
+
+    std::ofstream of(txt_name);
+    for (auto *os : std::array<std::ostream *, 2>{&std::cout, &of}) {
+      *os << "\nProfile (total; mean [min, max] in ms):\n";
+      for (const auto &[name, s] : flat) {
+        *os << name << " x " << s.count << " = " << double(s.total) / 1.0e6
+            << " ms; " << s.mean() / 1.0e6 << " [" << double(s.min) / 1.0e6
+            << ", " << double(s.max) / 1.0e6 << "]\n";
+      }
+    }
+    of << "\nCall tree:\n";
+    write_tree(of, tree, 0, 0);
+    std::cout << "Written to: " << base << ".txt/.csv/.json\n";
+
+    std::ofstream csv(base + ".csv");
+    csv << "name,count,total_ms,mean_ms,min_ms,max_ms\n";
+    for (const auto &[name, s] : flat) {
+      csv << name << "," << s.count << "," << double(s.total) / 1.0e6 << ","
+          << s.mean() / 1.0e6 << "," << double(s.min) / 1.0e6 << ","
+          << double(s.max) / 1.0e6 << "\n";
+    }
+
+    // Chrome trace format: complete ('X') events, times in us
+    std::ofstream json(base + ".json");
+    json << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto &log : m_logs) {
+      for (const auto &e : log->events) {
+        json << (first ? "" : ",\n") << "{\"name\":\""
+             << node_name(log->nodes[e.node]) << "\",\"ph\":\"X\",\"ts\":"
+             << double(e.start) / 1.0e3
+             << ",\"dur\":" << double(e.duration) / 1.0e3
+             << ",\"pid\":0,\"tid\":" << log->tid << "}";
+        first = false;
       }
     }
-    const auto &[name, time, count] = *p_worst;
-    std::cout << "\n ** Worst: \n";
-    std::cout << name << " x " << count << " = " << time / 1000.0 << " ms\n";
+    json << "\n],\"displayTimeUnit\":\"ms\"}\n";
   }
 };
 
+//------------------------------------------------------------------------------
+inline ThreadLog *thread_log() {
+  thread_local ThreadLog *log = Registry::get().new_thread();
+  return log;
+}
+
+} // namespace detail
+
 //******************************************************************************
+//! Scope timer: records time from construction to destruction into the
+//! calling thread's log. Use via safeProfiler().
 class Profiler {
-  friend class ProfileLog;
-  const std::string name;
-  const std::chrono::high_resolution_clock::time_point tstart;
-  inline static ProfileLog log;
+  detail::ThreadLog *const m_log;
+  const std::size_t m_node;
+  const std::int64_t m_start;
 
 public:
   Profiler(const char *in_name, const char *extra = "")
-      : name([&]() {
-          return std::string(extra) == ""
-                     ? std::string(in_name)
-                     : std::string(in_name) + "_" + std::string(extra);
-        }()),
-        tstart(std::chrono::high_resolution_clock::now()) {}
+      : m_log(detail::thread_log()),
+        m_node(m_log->child(in_name, extra)),
+        m_start(detail::Registry::get().now()) {
+    m_log->current = m_node;
+  }
+
+  Profiler(const Profiler &) = delete;
+  Profiler &operator=(const Profiler &) = delete;
 
   ~Profiler() {
-#pragma omp critical(add_entry)
-    {
-      const auto now = std::chrono::high_resolution_clock::now();
-      const auto duration =
-          std::chrono::duration_cast<std::chrono::microseconds>(now - tstart);
-      log.m_log.emplace_back(name, duration);
-    }
+    const auto duration = detail::Registry::get().now() - m_start;
+    auto &node = m_log->nodes[m_node];
+    node.stats.add(duration);
+    if (m_log->events.size() < max_trace_events)
+      m_log->events.push_back({m_node, m_start, duration});
+    m_log->current = node.parent;
   }
 };
 
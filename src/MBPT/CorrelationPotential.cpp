@@ -9,15 +9,32 @@
 #include "Maths/Grid.hpp"
 #include "Maths/Interpolator.hpp"
 #include "Maths/LinAlg_MatrixVector.hpp"
+#include "Physics/PhysConst_constants.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdio>
 #include <fstream>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
 #include <iostream>
 #include <numeric>
+#include <optional>
+#include <utility>
 #include <vector>
 
+// omp functions are not defined if not using -fopenmp
+#if defined(_OPENMP)
+#include <omp.h>
+#else
+#define omp_get_thread_num() 0
+#define omp_get_max_threads() 1
+#define omp_get_max_active_levels() 1
+#define omp_set_max_active_levels(n) (void)(n)
+#define omp_set_num_threads(n) (void)(n)
+#endif
+
 namespace MBPT {
 
 //******************************************************************************
@@ -34,7 +51,9 @@ CorrelationPotential::CorrelationPotential(
       m_6j(m_maxk),
       m_stride(subgridp.stride),
       m_include_G(sigp.include_G),
-      m_fk(std::move(sigp.fk)) {
+      m_fk(std::move(sigp.fk)),
+      m_checkpoint(sigp.checkpoint),
+      m_rank_tol(sigp.rank_tol) {
   setup_subGrid(subgridp.r0, subgridp.rmax);
 }
 
@@ -56,6 +75,69 @@ void CorrelationPotential::setup_subGrid(double rmin, double rmax) {
   }
 
   m_subgrid_points = m_subgrid_r.size();
+  setup_subGrid_maps();
+}
+
+//------------------------------------------------------------------------------
+void CorrelationPotential::setup_subGrid_maps() {
+  // Integration weights (dr) at each sub-grid point
+  m_subgrid_dr.resize(m_subgrid_points);
+  for (auto j = 0ul; j < m_subgrid_points; ++j) {
+    m_subgrid_dr[j] = dr_subToFull(j);
+  }
+
+  // Interpolation is linear in y: column j of the interpolation matrix is
+  // the interpolation of the j-th unit vector. Spline weights fall off
+  // exponentially away from r, so only keep the (contiguous) band of
+  // non-negligible weights for each full-grid point.
+  const auto num_full = p_gr->num_points;
+  m_interp_row.assign(num_full + 1, 0);
+  m_interp_j0.assign(num_full, 0);
+  m_interp_w.clear();
+  if (m_subgrid_points < 2)
+    return;
+
+  const Interpolator::Plan interp(m_subgrid_r, p_gr->r);
+  std::vector<double> cols(m_subgrid_points * num_full);
+  std::vector<double> e_j(m_subgrid_points, 0.0);
+  std::vector<double> col;
+  for (auto j = 0ul; j < m_subgrid_points; ++j) {
+    e_j[j] = 1.0;
+    interp.apply(e_j, &col);
+    std::copy(cbegin(col), cend(col), begin(cols) + long(j * num_full));
+    e_j[j] = 0.0;
+  }
+
+  const double eps = 1.0e-15;
+  for (auto i = 0ul; i < num_full; ++i) {
+    const auto w = [&](std::size_t j) { return cols[j * num_full + i]; };
+    auto j0 = 0ul, j1 = m_subgrid_points;
+    while (j0 < j1 && std::abs(w(j0)) < eps)
+      ++j0;
+    while (j1 > j0 && std::abs(w(j1 - 1)) < eps)
+      --j1;
+    m_interp_j0[i] = j0;
+    for (auto j = j0; j < j1; ++j)
+      m_interp_w.push_back(w(j));
+    m_interp_row[i + 1] = m_interp_w.size();
+  }
+}
+
+//------------------------------------------------------------------------------
+std::vector<double>
+CorrelationPotential::interp_subToFull(const std::vector<double> &y) const {
+  const auto num_full = m_interp_j0.size();
+  std::vector<double> out(num_full, 0.0);
+  for (auto i = 0ul; i < num_full; ++i) {
+    const auto *w = m_interp_w.data() + m_interp_row[i];
+    const auto *yi = y.data() + m_interp_j0[i];
+    const auto len = m_interp_row[i + 1] - m_interp_row[i];
+    double sum = 0.0;
+    for (auto k = 0ul; k < len; ++k)
+      sum += w[k] * yi[k];
+    out[i] = sum;
+  }
+  return out;
 }
 
 //******************************************************************************
@@ -93,6 +175,206 @@ const GMatrix *CorrelationPotential::getSigma(int n, int kappa) const {
   return (is < m_Sigma_kappa.size()) ? &m_Sigma_kappa[is] : nullptr;
 }
 
+//******************************************************************************
+void CorrelationPotential::formSigma(
+    const std::vector<AtomData::DiracSEnken> &nken_list) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
+  // Only form those that don't already exist (or are repeated in list):
+  std::vector<AtomData::DiracSEnken> todo;
+  for (const auto &nken : nken_list) {
+    const auto same = [&nken](const auto &x) {
+      return x.k == nken.k && x.n == nken.n;
+    };
+    if (std::any_of(cbegin(m_nk), cend(m_nk), same) ||
+        std::any_of(cbegin(todo), cend(todo), same))
+      continue;
+    todo.push_back(nken);
+  }
+  if (todo.empty())
+    return;
+
+  prep_Sigma();
+
+  // Add new Sigmas (zero) first, so each may be filled independently
+  const auto i0 = m_Sigma_kappa.size();
+  for (const auto &[n, kappa, en] : todo) {
+    m_nk.emplace_back(n, kappa, en);
+    m_Sigma_kappa.emplace_back(m_subgrid_points, m_include_G);
+  }
+
+  // Approximate (direct, exchange) energy shifts, for output
+  std::vector<std::optional<std::pair<double, double>>> de_list(todo.size());
+
+  // Share threads between the concurrent Sigmas: each 'outer' thread sets its
+  // own team size, used by the parallel regions inside calculate_Sigma
+  const auto num_tasks = int(todo.size());
+  const auto num_threads = omp_get_max_threads();
+  const auto num_outer = std::min(num_tasks, num_threads);
+  const auto max_levels = omp_get_max_active_levels();
+  omp_set_max_active_levels(std::max(max_levels, 2));
+
+#pragma omp parallel for num_threads(num_outer) schedule(dynamic)
+  for (int i = 0; i < num_tasks; ++i) {
+    const auto tid = omp_get_thread_num();
+    const auto num_inner =
+        num_threads / num_outer + (tid < num_threads % num_outer ? 1 : 0);
+    omp_set_num_threads(num_inner);
+
+    const auto [n, kappa, en] = todo[std::size_t(i)];
+    // if v.kappa > basis, then Ck angular factor won't exist!
+    if (Angular::twoj_k(kappa) > m_yeh.Ck().max_tj())
+      continue;
+
+    auto [Sigma_d, Sigma_x] = calculate_Sigma(kappa, en, n);
+
+    // find lowest excited state, for <v|S|v> energy shift:
+    const auto find_kappa = [kappa = kappa, n = n](const auto &a) {
+      return a.k == kappa && (a.n == n || n == 0);
+    };
+    const auto vk =
+        std::find_if(cbegin(m_excited), cend(m_excited), find_kappa);
+    if (vk != cend(m_excited)) {
+      // nb: just approximate (uses splines)
+      de_list[std::size_t(i)] = std::pair{*vk * act_G_Fv(Sigma_d, *vk),
+                                          *vk * act_G_Fv(Sigma_x, *vk)};
+    }
+
+    Sigma_d += Sigma_x;
+    m_Sigma_kappa[i0 + std::size_t(i)] = std::move(Sigma_d);
+  }
+  omp_set_max_active_levels(max_levels);
+
+  // Print D, X, (D+X) energy shifts
+  for (auto i = 0ul; i < todo.size(); ++i) {
+    const auto [n, kappa, en] = todo[i];
+    if (Angular::twoj_k(kappa) > m_yeh.Ck().max_tj()) {
+      std::cout << "Warning: angular not good\n";
+      continue;
+    }
+    printf("k=%2i at en=%8.5f.. ", kappa, en);
+    if (de_list[i]) {
+      const auto [deD, deX] = *de_list[i];
+      printf("de= %7.1f + %5.1f = ", deD * PhysConst::Hartree_invcm,
+             deX * PhysConst::Hartree_invcm);
+      printf("%7.1f", (deD + deX) * PhysConst::Hartree_invcm);
+    }
+    std::cout << "\n";
+  }
+
+  compress_Sigmas(i0);
+}
+
+//******************************************************************************
+std::pair<GMatrix, GMatrix>
+CorrelationPotential::calculate_Sigma(int kappa, double en, int n) const {
+  (void)kappa;
+  (void)en;
+  (void)n; // don't warn on unsused, want named
+  assert(false && "Cannot call formSigma on copied CorrelationPotential!");
+  return {GMatrix(m_subgrid_points, m_include_G),
+          GMatrix(m_subgrid_points, m_include_G)};
+}
+
+//******************************************************************************
+bool CorrelationPotential::open_checkpoint(std::fstream &iofs,
+                                           const std::string &stage,
+                                           std::vector<double> key,
+                                           IO::FRW::RoW rw) const {
+  if (m_checkpoint == "")
+    return false;
+  const auto fname = m_checkpoint + "." + stage + ".chk";
+  if (rw == IO::FRW::read && !IO::FRW::file_exists(fname))
+    return false;
+  IO::FRW::open_binary(iofs, rw == IO::FRW::write ? fname + ".tmp" : fname,
+                       rw);
+#pragma omp critical(checkpoint_files)
+  {
+    if (std::find(cbegin(m_checkpoint_files), cend(m_checkpoint_files),
+                  fname) == cend(m_checkpoint_files))
+      m_checkpoint_files.push_back(fname);
+  }
+
+  // (sub)grid parameters and basis are always part of key
+  const auto sum_en = [](const auto &orbs) {
+    return std::accumulate(cbegin(orbs), cend(orbs), 0.0,
+                           [](double x, const auto &Fa) { return x + Fa.en; });
+  };
+  key.insert(key.begin(),
+             {p_gr->r0, p_gr->rmax, p_gr->b, double(p_gr->num_points),
+              double(m_subgrid_points), double(m_imin), double(m_stride),
+              double(m_include_G), double(m_holes.size()),
+              double(m_excited.size()), sum_en(m_holes), sum_en(m_excited)});
+  auto file_key = key;
+  rw_binary(iofs, rw, file_key);
+  if (rw == IO::FRW::write)
+    return true;
+
+  const auto same = [](double a, double b) {
+    return std::abs(a - b) <= 1.0e-12 * std::max(1.0, std::abs(a));
+  };
+  return iofs.good() && file_key.size() == key.size() &&
+         std::equal(cbegin(key), cend(key), cbegin(file_key), same);
+}
+
+//------------------------------------------------------------------------------
+void CorrelationPotential::commit_checkpoint(std::fstream &iofs,
+                                             const std::string &stage) const {
+  const auto fname = m_checkpoint + "." + stage + ".chk";
+  iofs.close();
+  if (iofs.fail() || std::rename((fname + ".tmp").c_str(), fname.c_str()) != 0)
+    std::cout << "\nWarning: failed to write checkpoint " << fname << "\n";
+}
+
+//------------------------------------------------------------------------------
+bool CorrelationPotential::read_checkpoint(const std::string &stage,
+                                           const std::vector<double> &key,
+                                           GMatrix *Gmat) const {
+  std::fstream iofs;
+  if (!open_checkpoint(iofs, stage, key, IO::FRW::read))
+    return false;
+  for (auto *blk : {&Gmat->ff, &Gmat->fg, &Gmat->gf, &Gmat->gg}) {
+    if (blk != &Gmat->ff && !m_include_G)
+      continue;
+    for (auto i = 0ul; i < m_subgrid_points; ++i) {
+      for (auto j = 0ul; j < m_subgrid_points; ++j) {
+        rw_binary(iofs, IO::FRW::read, (*blk)[i][j]);
+      }
+    }
+  }
+  return iofs.good();
+}
+
+//------------------------------------------------------------------------------
+void CorrelationPotential::write_checkpoint(const std::string &stage,
+                                            const std::vector<double> &key,
+                                            GMatrix Gmat) const {
+  std::fstream iofs;
+  if (!open_checkpoint(iofs, stage, key, IO::FRW::write))
+    return;
+  for (auto *blk : {&Gmat.ff, &Gmat.fg, &Gmat.gf, &Gmat.gg}) {
+    if (blk != &Gmat.ff && !m_include_G)
+      continue;
+    for (auto i = 0ul; i < m_subgrid_points; ++i) {
+      for (auto j = 0ul; j < m_subgrid_points; ++j) {
+        rw_binary(iofs, IO::FRW::write, (*blk)[i][j]);
+      }
+    }
+  }
+  commit_checkpoint(iofs, stage);
+}
+
+//------------------------------------------------------------------------------
+void CorrelationPotential::remove_checkpoints() {
+  for (const auto &fname : m_checkpoint_files) {
+    std::remove(fname.c_str());
+  }
+  if (!m_checkpoint_files.empty())
+    std::cout << "Removed " << m_checkpoint_files.size()
+              << " checkpoint files\n";
+  m_checkpoint_files.clear();
+}
+
 //******************************************************************************
 DiracSpinor CorrelationPotential::SigmaFv(const DiracSpinor &v) const {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
@@ -104,10 +386,15 @@ DiracSpinor CorrelationPotential::SigmaFv(const DiracSpinor &v) const {
   // Aply lambda, if exists:
   const auto lambda = is >= m_lambda_kappa.size() ? 1.0 : m_lambda_kappa[is];
 
-  if (is < m_Sigma_kappa.size())
-    return lambda == 1.0 ? act_G_Fv(m_Sigma_kappa[is], v)
-                         : lambda * act_G_Fv(m_Sigma_kappa[is], v);
-  return 0.0 * v;
+  if (is >= m_Sigma_kappa.size())
+    return 0.0 * v;
+
+  const auto low_rank = is < m_Sigma_lr.size() && m_Sigma_lr[is].dim != 0;
+  auto Sv = low_rank ? act_lowrank_Fv(m_Sigma_lr[is], v)
+                     : act_G_Fv(m_Sigma_kappa[is], v);
+  if (lambda != 1.0)
+    Sv *= lambda;
+  return Sv;
 }
 
 //******************************************************************************
@@ -185,37 +472,39 @@ DiracSpinor CorrelationPotential::act_G_Fv(const GMatrix &Gmat,
   // Sigma|v> = int G(r1,r2)*v(r2) dr2
   // (S|v>)_i = sum_j G_ij v_j drdu_j du
   // nb: G is on sub-grid, |v> and S|v> on full-grid. Use interpolation
+  // Weighted v is gathered onto sub-grid, so each block is a single GEMV
 
-  const auto &gr = *(Fv.rgrid);
   auto SigmaFv = DiracSpinor(0, Fv.k, Fv.rgrid);
-  std::vector<double> f(m_subgrid_r.size());
-  std::vector<double> g;
-
-  for (auto i = 0ul; i < m_subgrid_points; ++i) {
-    for (auto j = 0ul; j < m_subgrid_points; ++j) {
-      const auto sj = ri_subToFull(j);
-      const auto dr = gr.drdu[sj] * gr.du * double(m_stride);
-      f[i] += Gmat.ff[i][j] * Fv.f[sj] * dr;
-    }
+  const auto n = m_subgrid_points;
+  if (n == 0)
+    return SigmaFv;
+  assert(Fv.rgrid->num_points == m_interp_j0.size());
+
+  std::vector<double> vf(n), vg(m_include_G ? n : 0);
+  for (auto j = 0ul; j < n; ++j) {
+    const auto sj = ri_subToFull(j);
+    vf[j] = Fv.f[sj] * m_subgrid_dr[j];
+    if (m_include_G)
+      vg[j] = Fv.g[sj] * m_subgrid_dr[j];
   }
 
+  std::vector<double> f(n), g(m_include_G ? n : 0);
+  auto VF = gsl_vector_view_array(vf.data(), n);
+  auto F = gsl_vector_view_array(f.data(), n);
+  gsl_blas_dgemv(CblasNoTrans, 1.0, Gmat.ff.m, &VF.vector, 0.0, &F.vector);
+
   if (m_include_G) {
-    g.resize(m_subgrid_r.size());
-    for (auto i = 0ul; i < m_subgrid_points; ++i) {
-      for (auto j = 0ul; j < m_subgrid_points; ++j) {
-        const auto sj = ri_subToFull(j);
-        const auto dr = gr.drdu[sj] * gr.du * double(m_stride);
-        f[i] += Gmat.fg[i][j] * Fv.g[sj] * dr;
-        g[i] += Gmat.gf[i][j] * Fv.f[sj] * dr;
-        g[i] += Gmat.gg[i][j] * Fv.g[sj] * dr;
-      }
-    }
+    auto VG = gsl_vector_view_array(vg.data(), n);
+    auto G = gsl_vector_view_array(g.data(), n);
+    gsl_blas_dgemv(CblasNoTrans, 1.0, Gmat.fg.m, &VG.vector, 1.0, &F.vector);
+    gsl_blas_dgemv(CblasNoTrans, 1.0, Gmat.gf.m, &VF.vector, 0.0, &G.vector);
+    gsl_blas_dgemv(CblasNoTrans, 1.0, Gmat.gg.m, &VG.vector, 1.0, &G.vector);
   }
 
   // Interpolate from sub-grid to full grid
-  SigmaFv.f = Interpolator::interpolate(m_subgrid_r, f, gr.r);
+  SigmaFv.f = interp_subToFull(f);
   if (m_include_G) {
-    SigmaFv.g = Interpolator::interpolate(m_subgrid_r, g, gr.r);
+    SigmaFv.g = interp_subToFull(g);
   }
 
   return SigmaFv;
@@ -252,6 +541,165 @@ double CorrelationPotential::act_G_Fv_2(const DiracSpinor &Fa,
   return aGb;
 }
 
+//******************************************************************************
+std::pair<CorrelationPotential::LowRankSigma, double>
+CorrelationPotential::compress_Sigma(const GMatrix &Gmat, double tol) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  // SVD of s.Sigma.s, with s = sqrt(dr): truncation error is then in the norm
+  // relevant for Sigma|v> (i.e., includes the integration weights)
+  const auto n = m_subgrid_points;
+  const auto dim = m_include_G ? 2 * n : n;
+  LowRankSigma lr{dim, 0, {}, {}};
+  if (n == 0)
+    return {lr, 0.0};
+
+  const auto s = [&](std::size_t i) { return std::sqrt(m_subgrid_dr[i % n]); };
+  const auto sigma = [&](std::size_t i, std::size_t j) {
+    if (i < n)
+      return j < n ? Gmat.ff[i][j] : Gmat.fg[i][j - n];
+    return j < n ? Gmat.gf[i - n][j] : Gmat.gg[i - n][j - n];
+  };
+
+  std::vector<double> a(dim * dim), v(dim * dim), sv(dim), work(dim);
+  for (auto i = 0ul; i < dim; ++i) {
+    for (auto j = 0ul; j < dim; ++j) {
+      a[i * dim + j] = s(i) * sigma(i, j) * s(j);
+    }
+  }
+  auto A = gsl_matrix_view_array(a.data(), dim, dim);
+  auto V = gsl_matrix_view_array(v.data(), dim, dim);
+  auto S = gsl_vector_view_array(sv.data(), dim);
+  auto W = gsl_vector_view_array(work.data(), dim);
+  // A -> U; singular values in decreasing order
+  gsl_linalg_SV_decomp(&A.matrix, &V.matrix, &S.vector, &W.vector);
+
+  // Smallest rank s.t. discarded part is below tol (relative Frobenius norm)
+  const auto total = std::inner_product(cbegin(sv), cend(sv), cbegin(sv), 0.0);
+  auto rank = dim;
+  auto discarded = 0.0;
+  while (rank > 0 &&
+         discarded + sv[rank - 1] * sv[rank - 1] <= tol * tol * total) {
+    discarded += sv[rank - 1] * sv[rank - 1];
+    --rank;
+  }
+
+  // Sigma_ij = sum_k (U_ik S_k / s_i) (V_jk / s_j)
+  lr.rank = rank;
+  lr.u.resize(rank * dim);
+  lr.w.resize(rank * dim);
+  for (auto k = 0ul; k < rank; ++k) {
+    for (auto i = 0ul; i < dim; ++i) {
+      lr.u[k * dim + i] = a[i * dim + k] * sv[k] / s(i);
+      lr.w[k * dim + i] = v[i * dim + k] / s(i);
+    }
+  }
+  const auto error = total == 0.0 ? 0.0 : std::sqrt(discarded / total);
+  return {std::move(lr), error};
+}
+
+//------------------------------------------------------------------------------
+void CorrelationPotential::expand_Sigma(const LowRankSigma &lr,
+                                        GMatrix *Gmat) const {
+  Gmat->zero();
+  const auto n = m_subgrid_points;
+  const auto dim = lr.dim;
+  if (lr.rank == 0 || n == 0)
+    return;
+  assert(dim == (m_include_G ? 2 * n : n));
+
+  // Sigma = U^T.W
+  std::vector<double> a(dim * dim);
+  auto U = gsl_matrix_const_view_array(lr.u.data(), lr.rank, dim);
+  auto W = gsl_matrix_const_view_array(lr.w.data(), lr.rank, dim);
+  auto A = gsl_matrix_view_array(a.data(), dim, dim);
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, &U.matrix, &W.matrix, 0.0,
+                 &A.matrix);
+
+  for (auto i = 0ul; i < n; ++i) {
+    for (auto j = 0ul; j < n; ++j) {
+      Gmat->ff[i][j] = a[i * dim + j];
+      if (m_include_G) {
+        Gmat->fg[i][j] = a[i * dim + n + j];
+        Gmat->gf[i][j] = a[(n + i) * dim + j];
+        Gmat->gg[i][j] = a[(n + i) * dim + n + j];
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void CorrelationPotential::compress_Sigmas(std::size_t i0) {
+  if (m_rank_tol <= 0.0 || i0 >= m_Sigma_kappa.size())
+    return;
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
+  std::cout << "Low-rank Sigma, tolerance: " << m_rank_tol << "\n";
+  m_Sigma_lr.resize(m_Sigma_kappa.size());
+  for (auto is = i0; is < m_Sigma_kappa.size(); ++is) {
+    const auto [n, kappa, en] = m_nk[is];
+    (void)en;
+    auto &Gmat = m_Sigma_kappa[is];
+    auto [lr, error] = compress_Sigma(Gmat, m_rank_tol);
+
+    // Change in <v|Sigma|v>, for lowest excited state (if basis exists)
+    const auto find_kappa = [kappa = kappa, n = n](const auto &a) {
+      return a.k == kappa && (a.n == n || n == 0);
+    };
+    const auto vk =
+        std::find_if(cbegin(m_excited), cend(m_excited), find_kappa);
+    const auto de0 = vk != cend(m_excited) ? *vk * act_G_Fv(Gmat, *vk) : 0.0;
+
+    printf("k=%2i: rank %3zu/%zu, |dS|/|S| = %.1e", kappa, lr.rank, lr.dim,
+           error);
+    if (vk != cend(m_excited)) {
+      const auto de1 = *vk * act_lowrank_Fv(lr, *vk);
+      printf(", d(de) = %.1e cm^-1", (de1 - de0) * PhysConst::Hartree_invcm);
+    }
+    std::cout << "\n";
+
+    expand_Sigma(lr, &Gmat);
+    m_Sigma_lr[is] = std::move(lr);
+  }
+}
+
+//------------------------------------------------------------------------------
+DiracSpinor CorrelationPotential::act_lowrank_Fv(const LowRankSigma &lr,
+                                                 const DiracSpinor &Fv) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  // Sigma|v> = sum_k |u_k> (w_k.v): weighted v gathered onto sub-grid (as in
+  // act_G_Fv), then two GEMVs
+
+  auto SigmaFv = DiracSpinor(0, Fv.k, Fv.rgrid);
+  const auto n = m_subgrid_points;
+  const auto dim = lr.dim;
+  if (n == 0 || lr.rank == 0)
+    return SigmaFv;
+
+  std::vector<double> v(dim), t(lr.rank), y(dim);
+  for (auto j = 0ul; j < n; ++j) {
+    const auto sj = ri_subToFull(j);
+    v[j] = Fv.f[sj] * m_subgrid_dr[j];
+    if (dim > n)
+      v[n + j] = Fv.g[sj] * m_subgrid_dr[j];
+  }
+
+  auto U = gsl_matrix_const_view_array(lr.u.data(), lr.rank, dim);
+  auto W = gsl_matrix_const_view_array(lr.w.data(), lr.rank, dim);
+  auto V = gsl_vector_view_array(v.data(), dim);
+  auto T = gsl_vector_view_array(t.data(), lr.rank);
+  auto Y = gsl_vector_view_array(y.data(), dim);
+  gsl_blas_dgemv(CblasNoTrans, 1.0, &W.matrix, &V.vector, 0.0, &T.vector);
+  gsl_blas_dgemv(CblasTrans, 1.0, &U.matrix, &T.vector, 0.0, &Y.vector);
+
+  // Interpolate from sub-grid to full grid
+  SigmaFv.f = interp_subToFull({cbegin(y), cbegin(y) + long(n)});
+  if (dim > n) {
+    SigmaFv.g = interp_subToFull({cbegin(y) + long(n), cend(y)});
+  }
+
+  return SigmaFv;
+}
+
 //******************************************************************************
 double CorrelationPotential::SOEnergyShift(const DiracSpinor &v,
                                            const DiracSpinor &w,
@@ -379,6 +827,9 @@ bool CorrelationPotential::read_write(const std::string &fname,
   for (auto i = 0ul; i < m_subgrid_r.size(); ++i) {
     rw_binary(iofs, rw, m_subgrid_r[i]);
   }
+  if (rw == IO::FRW::read) {
+    setup_subGrid_maps();
+  }
 
   // Number of kappas (number of Sigma/G matrices)
   std::size_t num_kappas = rw == IO::FRW::write ? m_Sigma_kappa.size() : 0;
@@ -387,9 +838,20 @@ bool CorrelationPotential::read_write(const std::string &fname,
     m_Sigma_kappa.resize(num_kappas, {m_subgrid_points, m_include_G});
   }
 
+  // Low-rank form is written only if every Sigma has one
+  const auto has_lr = [](const auto &lr) { return lr.dim != 0; };
+  const bool write_lr =
+      rw == IO::FRW::write && !m_Sigma_kappa.empty() &&
+      m_Sigma_lr.size() == m_Sigma_kappa.size() &&
+      std::all_of(cbegin(m_Sigma_lr), cend(m_Sigma_lr), has_lr);
+
   // Check if include FG/GG written. Note: doesn't matter if mis-match?!
-  auto incl_g = rw == IO::FRW::write ? m_include_G : 0;
+  // Second bit flags low-rank form (so older files are still read)
+  auto incl_g = rw == IO::FRW::write ? int(m_include_G) + (write_lr ? 2 : 0)
+                                     : 0;
   rw_binary(iofs, rw, incl_g);
+  const bool low_rank = incl_g & 2;
+  incl_g &= 1;
 
   if (rw == IO::FRW::read) {
     m_nk.resize(num_kappas);
@@ -398,8 +860,36 @@ bool CorrelationPotential::read_write(const std::string &fname,
     rw_binary(iofs, rw, n, k, en);
   }
 
+  if (low_rank) {
+    if (rw == IO::FRW::read) {
+      m_Sigma_lr.resize(num_kappas);
+    }
+    const auto n = m_subgrid_points;
+    const auto dim = m_include_G ? 2 * n : n;
+    for (auto is = 0ul; is < m_Sigma_lr.size(); ++is) {
+      auto &lr = m_Sigma_lr[is];
+      rw_binary(iofs, rw, lr.dim, lr.rank, lr.u, lr.w);
+      if (rw == IO::FRW::write)
+        continue;
+      if (lr.dim != dim) {
+        // FG/GG in file, but not wanted (or vice-versa): copy f (+g) part
+        LowRankSigma tmp{dim, lr.rank, std::vector<double>(lr.rank * dim),
+                         std::vector<double>(lr.rank * dim)};
+        const auto len = std::min(dim, lr.dim);
+        for (auto k = 0ul; k < lr.rank; ++k) {
+          std::copy_n(lr.u.data() + k * lr.dim, len, tmp.u.data() + k * dim);
+          std::copy_n(lr.w.data() + k * lr.dim, len, tmp.w.data() + k * dim);
+        }
+        lr = std::move(tmp);
+      }
+      expand_Sigma(lr, &m_Sigma_kappa[is]);
+    }
+  }
+
   // Read/Write G matrices
   for (auto &Gk : m_Sigma_kappa) {
+    if (low_rank)
+      break;
     for (auto i = 0ul; i < m_subgrid_points; ++i) {
       for (auto j = 0ul; j < m_subgrid_points; ++j) {
         rw_binary(iofs, rw, Gk.ff[i][j]);
@@ -412,10 +902,25 @@ bool CorrelationPotential::read_write(const std::string &fname,
     }
   }
   std::cout << "done.\n";
+  if (rw == IO::FRW::read && !low_rank) {
+    compress_Sigmas(0);
+  }
+  if (low_rank) {
+    std::cout << "Low-rank Sigma, rank:";
+    for (const auto &lr : m_Sigma_lr)
+      std::cout << " " << lr.rank << "/" << lr.dim;
+    std::cout << "\n";
+  }
   if (rw == IO::FRW::read) {
     std::cout << "Sigma basis: " << basis_config << "\n";
     print_info();
   }
+  // Final Sigma file written: checkpoints are no longer needed
+  if (rw == IO::FRW::write) {
+    iofs.close();
+    if (!iofs.fail())
+      remove_checkpoints();
+  }
   return true;
 }
 
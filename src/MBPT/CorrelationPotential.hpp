@@ -6,6 +6,9 @@
 #include "Physics/AtomData.hpp" //DiracSEnken
 #include "Wavefunction/DiracSpinor.hpp"
 #include <cassert>
+#include <fstream>
+#include <string>
+#include <utility>
 #include <vector>
 class Grid;
 namespace HF {
@@ -36,6 +39,16 @@ struct Sigma_params {
   bool holeParticle{false};
 
   std::vector<double> fk{}; // this for Goldstone too..
+  // Feynman: store intermediate (omega-dependent) matrices in single precision
+  bool single_precision{false};
+  // Base filename for checkpoint files (for restarts). Blank for none
+  std::string checkpoint{};
+  // Feynman: adaptive Im(w) grid; relative tolerance for Sigma energies (0 for
+  // none: use full grid)
+  double omega_tol{0.0};
+  // Relative tolerance for low-rank (truncated SVD) form of Sigma, used for
+  // SigmaFv and Sigma file (0 for none: dense)
+  double rank_tol{0.0};
 };
 
 struct rgrid_params {
@@ -91,17 +104,18 @@ public:
 public:
   virtual ~CorrelationPotential() = default;
 
-  // Calculates Sigma, for given kappa, energy, and stores.
-  // Also stored "lookup table" including n
-  // n may be zero (means)
-  // This should be virtual?
-  // nb: should do nothing if sigma already exists??
-  virtual void formSigma(int kappa, double en, int n = 0) {
-    (void)kappa;
-    (void)en;
-    (void)n; // don't warn on unsused, want named
-    assert(false && "Cannot call formSigma on copied CorrelationPotential!");
-  };
+  //! Calculates Sigma, for given kappa, energy, and stores.
+  //! @details Also stored "lookup table" including n. n may be zero (means
+  //! lowest). Does nothing if sigma already exists.
+  void formSigma(int kappa, double en, int n = 0) {
+    formSigma({AtomData::DiracSEnken{n, kappa, en}});
+  }
+
+  //! Calculates + stores Sigma for each {n, kappa, en} in list.
+  //! @details Each Sigma is formed concurrently, with the available threads
+  //! shared between them; data common to each kappa (e.g., Q^k, V_x, omega
+  //! grids) are formed once beforehand. Skips those that already exist.
+  void formSigma(const std::vector<AtomData::DiracSEnken> &nken_list);
 
   const GMatrix *getSigma(int n, int kappa) const;
 
@@ -162,7 +176,62 @@ public:
                     const DiracSpinor &Fb) const;
 
 protected:
+  // Low-rank (truncated SVD) form of Sigma: Sigma_ij = sum_k u_ki * w_kj.
+  // i,j run over [f, g] on the sub-grid (dim = n, or 2n if include_G); u, w
+  // are stored row-major (rank x dim). dim=0 means not compressed
+  struct LowRankSigma {
+    std::size_t dim{0}, rank{0};
+    std::vector<double> u{}, w{};
+  };
+
+  // Called once (before any Sigma formed) in formSigma. Forms any data shared
+  // between each kappa
+  virtual void prep_Sigma() {}
+
+  // Calculates direct and exchange parts of Sigma, for given kappa, energy.
+  // Must be thread-safe: called concurrently for different kappas
+  virtual std::pair<GMatrix, GMatrix> calculate_Sigma(int kappa, double en,
+                                                      int n) const;
+
+  // Checkpoints, for restarting long calculations: one file per stage, stored
+  // alongside Sigma file (only if m_checkpoint is set). Header includes the
+  // (sub)grid and 'key', so checkpoints from different calculations are not
+  // used. Files are written to temporary file, then renamed (atomic).
+
+  // Opens checkpoint file, and reads/writes header. For read, returns false
+  // if file doesn't exist or doesn't match. For write, must then call
+  // commit_checkpoint.
+  bool open_checkpoint(std::fstream &iofs, const std::string &stage,
+                       std::vector<double> key, IO::FRW::RoW rw) const;
+  // Closes (written) checkpoint file, and moves into place
+  void commit_checkpoint(std::fstream &iofs, const std::string &stage) const;
+  // Reads Gmat from checkpoint file, if exists (returns false otherwise)
+  bool read_checkpoint(const std::string &stage, const std::vector<double> &key,
+                       GMatrix *Gmat) const;
+  void write_checkpoint(const std::string &stage,
+                        const std::vector<double> &key, GMatrix Gmat) const;
+  // Deletes checkpoint files: called once final Sigma file is written
+  void remove_checkpoints();
+
   void setup_subGrid(double rmin, double rmax);
+  // Forms sub-grid integration weights and interpolation matrix (below).
+  // Must be called whenever the sub-grid changes
+  void setup_subGrid_maps();
+  // Interpolates y (on sub-grid) onto full grid, using interpolation matrix
+  std::vector<double> interp_subToFull(const std::vector<double> &y) const;
+
+  // Truncated SVD of Sigma, keeping smallest rank with relative (r-weighted,
+  // Frobenius) error below tol. Returns {low-rank form, error}
+  std::pair<LowRankSigma, double> compress_Sigma(const GMatrix &Gmat,
+                                                 double tol) const;
+  // Forms (dense) Gmat from low-rank form
+  void expand_Sigma(const LowRankSigma &lr, GMatrix *Gmat) const;
+  // Compresses Sigmas [i0, end) with m_rank_tol: replaces dense Sigma with
+  // low-rank approximation (so all uses are consistent); prints rank, error
+  void compress_Sigmas(std::size_t i0);
+  // Sigma|v>, using low-rank form: O(N*rank)
+  DiracSpinor act_lowrank_Fv(const LowRankSigma &lr,
+                             const DiracSpinor &Fv) const;
 
   // Adds new |ket><bra| term to G; uses sub-grid
   void addto_G(GMatrix *Gmat, const DiracSpinor &ket, const DiracSpinor &bra,
@@ -202,6 +271,13 @@ protected:
   std::size_t m_imin{};
   // Values for r on the subgrid
   std::vector<double> m_subgrid_r{};
+  // Integration weights (dr) at each sub-grid point
+  std::vector<double> m_subgrid_dr{};
+  // Sub-grid -> full grid (cubic spline) interpolation, as a banded sparse
+  // matrix: full-grid point i has weights m_interp_w[m_interp_row[i],
+  // m_interp_row[i+1]), for sub-grid points m_interp_j0[i], m_interp_j0[i]+1..
+  std::vector<std::size_t> m_interp_row{}, m_interp_j0{};
+  std::vector<double> m_interp_w{};
 
   // m_Sigma_kappa: holds Sigma matrix for each partial-wave, kappa
   std::vector<GMatrix> m_Sigma_kappa{};
@@ -217,6 +293,16 @@ protected:
   // Effective screening parameters
   std::vector<double> m_fk{}; // e.g., {0.72, 0.62, 0.83, 0.89, 0.94, 1.0};
 
+  // Base filename for checkpoint files; blank means don't use checkpoints
+  std::string m_checkpoint{};
+  // Checkpoint files read or written (deleted once Sigma file written)
+  mutable std::vector<std::string> m_checkpoint_files{};
+
+  // Relative tolerance for low-rank form of Sigma (0 for none)
+  double m_rank_tol{0.0};
+  // Low-rank form of m_Sigma_kappa (same order); empty if none compressed
+  std::vector<LowRankSigma> m_Sigma_lr{};
+
   double get_fk(int k) const {
     if (k < int(m_fk.size())) {
       return m_fk[std::size_t(k)];
@@ -1,4 +1,9 @@
 #pragma once
+#include "MBPT/FeynmanSigma.hpp"
+#include "MBPT/GoldstoneSigma.hpp"
+#include "MBPT/GreenMatrix.hpp"
+#include "MBPT/TensorProduct.hpp"
+#include "Physics/PhysConst_constants.hpp"
 #include "Wavefunction/BSplineBasis.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
 #include "Wavefunction/Wavefunction.hpp"
@@ -6,7 +11,10 @@
 #include "qip/Maths.hpp"
 #include "qip/Vector.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <string>
+#include <vector>
 
 namespace UnitTest {
 
@@ -15,6 +23,218 @@ namespace UnitTest {
 bool CorrelationPotential(std::ostream &obuff) {
   bool pass = true;
 
+  { // Single/double-precision (packed) storage of intermediate G matrices
+    const auto size = 60ul;
+    MBPT::ComplexGMatrix a(size, true), b(size, true);
+    for (auto *ab : {&a, &b}) {
+      for (auto *blk : {&ab->ff, &ab->fg, &ab->gf, &ab->gg}) {
+        for (auto i = 0ul; i < size; ++i) {
+          for (auto j = 0ul; j < size; ++j) {
+            const auto x = double(i + 1) / double(j + 2);
+            (*blk)[i][j] = LinAlg::ComplexDouble(std::sin(x), x * std::cos(x))
+                               .val;
+          }
+        }
+      }
+    }
+    const auto x = LinAlg::ComplexDouble{0.3, -1.7};
+    // Reference: (double) element-wise product
+    const auto ref = (x * mult_elements(a, b)).get_real();
+
+    for (const auto single : {false, true}) {
+      const auto pa = MBPT::PackedComplexGMatrix(a, single);
+      const auto pb = MBPT::PackedComplexGMatrix(b, single);
+      MBPT::GMatrix res(size, true);
+      add_Re_product(&res, x, pa, pb);
+      double eps = 0.0, max_ref = 0.0;
+      const auto blocks = [](const MBPT::GMatrix &g) {
+        return std::vector{&g.ff, &g.fg, &g.gf, &g.gg};
+      };
+      const auto b_res = blocks(res);
+      const auto b_ref = blocks(ref);
+      for (auto ib = 0ul; ib < b_res.size(); ++ib) {
+        for (auto i = 0ul; i < size; ++i) {
+          for (auto j = 0ul; j < size; ++j) {
+            eps = std::max(eps, std::abs((*b_res[ib])[i][j] -
+                                         (*b_ref[ib])[i][j]));
+            max_ref = std::max(max_ref, std::abs((*b_ref[ib])[i][j]));
+          }
+        }
+      }
+      eps /= max_ref;
+      const auto eps_unpack = MBPT::PackedComplexGMatrix(pa.unpack(), false)
+                                  .rel_error(a);
+      const auto name = single ? "float" : "double";
+      pass &= qip::check_value(&obuff,
+                               std::string("Packed G ") + name + " product",
+                               eps, 0.0, single ? 1.0e-6 : 1.0e-13);
+      pass &= qip::check_value(&obuff,
+                               std::string("Packed G ") + name + " unpack",
+                               eps_unpack, 0.0, single ? 1.0e-7 : 1.0e-15);
+    }
+  }
+
+  { // tensor_5_product (BLAS) vs. reference (explicit loops)
+    // Odd/small sizes (incl. 1: single sub-grid point), and c real/complex
+    for (const auto size : {1ul, 2ul, 7ul, 13ul, 32ul}) {
+      for (const auto c_real : {false, true}) {
+        std::vector<MBPT::ComplexGMatrix> m(5, {size, false});
+        for (auto im = 0ul; im < m.size(); ++im) {
+          for (auto i = 0ul; i < size; ++i) {
+            for (auto j = 0ul; j < size; ++j) {
+              const auto x = double(i + 2 * im + 1) / double(j + im + 2);
+              const auto y = (c_real && im == 2) ? 0.0 : x * std::cos(x);
+              m[im].ff[i][j] = LinAlg::ComplexDouble(std::sin(x), y).val;
+            }
+          }
+        }
+        const auto x = LinAlg::ComplexDouble{0.3, -1.7};
+        // result is added to: start from non-zero
+        MBPT::GMatrix res(size, false), ref(size, false);
+        for (auto i = 0ul; i < size; ++i) {
+          for (auto j = 0ul; j < size; ++j) {
+            res.ff[i][j] = ref.ff[i][j] = double(i) - 0.5 * double(j);
+          }
+        }
+        MBPT::tensor_5_product(&res, x, m[0], m[1], m[2], m[3], m[4]);
+        MBPT::tensor_5_product_ref(&ref, x, m[0], m[1], m[2], m[3], m[4]);
+        double eps = 0.0, max_ref = 0.0;
+        for (auto i = 0ul; i < size; ++i) {
+          for (auto j = 0ul; j < size; ++j) {
+            eps = std::max(eps, std::abs(res.ff[i][j] - ref.ff[i][j]));
+            max_ref = std::max(max_ref, std::abs(ref.ff[i][j]));
+          }
+        }
+        pass &= qip::check_value(
+            &obuff,
+            "tensor_5_product n=" + std::to_string(size) +
+                (c_real ? " c:real" : " c:complex"),
+            eps / max_ref, 0.0, 1.0e-14);
+      }
+    }
+  }
+
+  { // Feynman: G(e_r + iw) from G(e_r) [Green_hf_real + GreenAtComplex] vs.
+    // direct complex inversion [Green]; including e_r at a HF eigenvalue
+    Wavefunction wf({2000, 1.0e-6, 120.0, 0.33 * 120.0, "loglinear", -1.0},
+                    {"Cs", -1, "Fermi", -1.0, -1.0}, 1.0);
+    wf.hartreeFockCore("HartreeFock", 0.0, "[Xe]");
+    wf.hartreeFockValence("7sp");
+    wf.formBasis({"30spdf", 40, 7, 0.0, 1.0e-6, 40.0, false});
+
+    const auto Fs6 = wf.getState("6s");
+    const auto Fs7 = wf.getState("7s");
+    const auto stride =
+        (wf.rgrid->getIndex(30.0) - wf.rgrid->getIndex(1.0e-4)) / 150;
+
+    // With this omre, G(e_r) for 7s (kappa=-1) is exactly at the 6s pole
+    auto sigp = MBPT::Sigma_params{MBPT::Method::Feynman, 3};
+    sigp.max_l_excited = 3;
+    sigp.real_omega = Fs6->en - Fs7->en;
+    const MBPT::FeynmanSigma Sigma(wf.getHF(), wf.basis, sigp,
+                                   {1.0e-4, 30.0, stride}, "");
+
+    // Largest element of G (real or imag)
+    const auto max_abs = [](const MBPT::ComplexGMatrix &G) {
+      const auto [re, im] = G.max_el();
+      return std::max(std::abs(re), std::abs(im));
+    };
+
+    double eps_G = 0.0;
+    for (const auto &Fv : wf.valence) {
+      for (const auto e_r : {Fs6->en, Fv.en - 0.2, Fv.en + sigp.real_omega}) {
+        const auto Gr = Sigma.Green_hf_real(Fv.k, e_r);
+        for (const auto w : {0.01, 0.1, 1.0, 10.0}) {
+          const auto G = Sigma.Green(Fv.k, {e_r, w});
+          const auto G_r = Gr ? Sigma.GreenAtComplex(*Gr, w) : G;
+          eps_G = std::max(eps_G, max_abs(G_r - G) / max_abs(G));
+        }
+      }
+    }
+    pass &= qip::check_value(&obuff, "Feynman G(e_r+iw) from G(e_r)", eps_G,
+                             0.0, 1.0e-6);
+
+    // Direct Sigma energies: G from G(e_r) vs. direct complex inversion
+    double eps_de = 0.0;
+    for (const auto Fv : {Fs6, Fs7}) {
+      const auto Sd_r = Sigma.FeynmanDirect(Fv->k, Fv->en);
+      const auto Sd_c = Sigma.FeynmanDirect(Fv->k, Fv->en, -1, false);
+      const auto de_r = *Fv * Sigma.act_G_Fv(Sd_r, *Fv);
+      const auto de_c = *Fv * Sigma.act_G_Fv(Sd_c, *Fv);
+      eps_de = std::max(eps_de, std::abs((de_r - de_c) / de_c));
+    }
+    pass &= qip::check_value(&obuff, "Feynman Sigma from G(e_r)", eps_de, 0.0,
+                             1.0e-6);
+  }
+
+  { // Feynman: adaptive Im(w) grid (omega_tol) vs. full grid
+    Wavefunction wf({2000, 1.0e-6, 120.0, 0.33 * 120.0, "loglinear", -1.0},
+                    {"Cs", -1, "Fermi", -1.0, -1.0}, 1.0);
+    wf.hartreeFockCore("HartreeFock", 0.0, "[Xe]");
+    wf.hartreeFockValence("6sp");
+    wf.formBasis({"30spdf", 40, 7, 0.0, 1.0e-6, 40.0, false});
+
+    const auto stride =
+        (wf.rgrid->getIndex(30.0) - wf.rgrid->getIndex(1.0e-4)) / 150;
+    const MBPT::rgrid_params subgridp{1.0e-4, 30.0, stride};
+    auto sigp = MBPT::Sigma_params{MBPT::Method::Feynman, 3};
+    sigp.max_l_excited = 3;
+    MBPT::FeynmanSigma Sigma_full(wf.getHF(), wf.basis, sigp, subgridp, "");
+    sigp.omega_tol = 1.0e-3;
+    MBPT::FeynmanSigma Sigma_adapt(wf.getHF(), wf.basis, sigp, subgridp, "");
+
+    std::vector<AtomData::DiracSEnken> nken_list;
+    for (const auto &Fv : wf.valence)
+      nken_list.emplace_back(Fv.n, Fv.k, Fv.en);
+    Sigma_full.formSigma(nken_list);
+    Sigma_adapt.formSigma(nken_list);
+
+    double eps = 0.0;
+    for (const auto &Fv : wf.valence) {
+      const auto de_full = Fv * Sigma_full.SigmaFv(Fv);
+      const auto de_adapt = Fv * Sigma_adapt.SigmaFv(Fv);
+      eps = std::max(eps, std::abs((de_adapt - de_full) / de_full));
+    }
+    pass &= qip::check_value(&obuff, "Feynman adaptive Im(w) grid", eps, 0.0,
+                             sigp.omega_tol);
+  }
+
+  { // Feynman: intermediate (w-dependent) matrices stored in single precision
+    // (PackedComplexGMatrix) vs. double: Sigma energies, in cm^-1
+    Wavefunction wf({2000, 1.0e-6, 120.0, 0.33 * 120.0, "loglinear", -1.0},
+                    {"Cs", -1, "Fermi", -1.0, -1.0}, 1.0);
+    wf.hartreeFockCore("HartreeFock", 0.0, "[Xe]");
+    wf.hartreeFockValence("6sp");
+    wf.formBasis({"30spdf", 40, 7, 0.0, 1.0e-6, 40.0, false});
+
+    const auto stride =
+        (wf.rgrid->getIndex(30.0) - wf.rgrid->getIndex(1.0e-4)) / 150;
+    const MBPT::rgrid_params subgridp{1.0e-4, 30.0, stride};
+    auto sigp = MBPT::Sigma_params{MBPT::Method::Feynman, 3};
+    sigp.max_l_excited = 3;
+    MBPT::FeynmanSigma Sigma_dp(wf.getHF(), wf.basis, sigp, subgridp, "");
+    sigp.single_precision = true;
+    MBPT::FeynmanSigma Sigma_sp(wf.getHF(), wf.basis, sigp, subgridp, "");
+
+    std::vector<AtomData::DiracSEnken> nken_list;
+    for (const auto &Fv : wf.valence)
+      nken_list.emplace_back(Fv.n, Fv.k, Fv.en);
+    Sigma_dp.formSigma(nken_list);
+    Sigma_sp.formSigma(nken_list);
+
+    // <v|Sigma|v> ~ 10^3 cm^-1; float has ~7 significant figures. Bound is
+    // far below any physical uncertainty (~1 cm^-1)
+    double del_cm = 0.0;
+    for (const auto &Fv : wf.valence) {
+      const auto de_dp = Fv * Sigma_dp.SigmaFv(Fv);
+      const auto de_sp = Fv * Sigma_sp.SigmaFv(Fv);
+      del_cm = std::max(del_cm, std::abs(de_sp - de_dp));
+    }
+    del_cm *= PhysConst::Hartree_invcm;
+    pass &= qip::check_value(&obuff, "Feynman single precision (cm^-1)", del_cm,
+                             0.0, 1.0e-3);
+  }
+
   { // Compare with  K. Beloy and A. Derevianko,
     // Comput. Phys. Commun. 179, 310 (2008).
     Wavefunction wf({4000, 1.0e-6, 100.0, 0.33 * 100.0, "loglinear", -1.0},
@@ -62,7 +282,6 @@ bool CorrelationPotential(std::ostream &obuff) {
     }
   }
 
-  //****************************************************************************
   { // Compare Dzuba, only using up to l=4 for splines
     // Note: Works pretty well up to f states (not sure if difference is ok)
     auto dzuba_g = std::vector{
@@ -77,6 +296,51 @@ bool CorrelationPotential(std::ostream &obuff) {
     wf.formBasis({"30spdfg", 40, 7, 0.0, 1.0e-6, 40.0, false});
     wf.formSigma(3, true, 1.0e-4, 30.0, 14 /*stride*/);
 
+    { // Low-rank (truncated SVD) Sigma: formed with rank_tol, vs. dense
+      // (same sub-grid + energies): <v|Sigma|v>. Then, low-rank Sigma file
+      // read/write; read in with FG/GG also (dimension mis-match)
+      const std::string fname = "tmp_CorrelationPotential_test.sig2";
+      auto sigp = MBPT::Sigma_params{MBPT::Method::Goldstone, 3};
+      sigp.rank_tol = 1.0e-6;
+      const MBPT::rgrid_params subgridp{1.0e-4, 30.0, 14};
+      // Lowest valence state of each kappa (as in Wavefunction::formSigma)
+      std::vector<AtomData::DiracSEnken> nken_list;
+      for (int ki = 0; ki <= DiracSpinor::max_kindex(wf.valence); ++ki) {
+        const auto is_ki = [ki](const auto &f) { return f.k_index() == ki; };
+        const auto Fv =
+            std::find_if(cbegin(wf.valence), cend(wf.valence), is_ki);
+        if (Fv != cend(wf.valence))
+          nken_list.emplace_back(Fv->n, Fv->k, Fv->en);
+      }
+
+      std::remove(fname.c_str()); // don't read an old file
+      MBPT::GoldstoneSigma Sigma_lr(wf.getHF(), wf.basis, sigp, subgridp, "");
+      Sigma_lr.formSigma(nken_list);
+      Sigma_lr.read_write(fname, IO::FRW::write);
+      const MBPT::GoldstoneSigma Sigma_rd(wf.getHF(), wf.basis, sigp, subgridp,
+                                          fname);
+      sigp.include_G = true;
+      const MBPT::GoldstoneSigma Sigma_rdG(wf.getHF(), wf.basis, sigp,
+                                           subgridp, fname);
+      std::remove(fname.c_str());
+
+      std::vector<double> de0, de_lr, de_rd, de_rdG;
+      for (const auto &Fv : wf.valence) {
+        de0.push_back(Fv * wf.getSigma()->SigmaFv(Fv));
+        de_lr.push_back(Fv * Sigma_lr.SigmaFv(Fv));
+        de_rd.push_back(Fv * Sigma_rd.SigmaFv(Fv));
+        de_rdG.push_back(Fv * Sigma_rdG.SigmaFv(Fv));
+      }
+      const auto eps_lr = qip::compare_eps(de_lr, de0).first;
+      const auto eps_rd = qip::compare_eps(de_rd, de_lr).first;
+      const auto eps_rdG = qip::compare_eps(de_rdG, de_lr).first;
+      pass &= qip::check_value(&obuff, "Sigma2 low-rank", eps_lr, 0.0, 1.0e-5);
+      pass &= qip::check_value(&obuff, "Sigma2 low-rank r/w", eps_rd, 0.0,
+                               1.0e-14);
+      pass &= qip::check_value(&obuff, "Sigma2 low-rank r/w (+G)", eps_rdG,
+                               0.0, 1.0e-14);
+    }
+
     std::vector<double> hf, br2;
     for (const auto &Fv : wf.valence) {
       hf.push_back(Fv.en);
@@ -8,11 +8,13 @@
 #include "IO/SafeProfiler.hpp"
 #include "MBPT/CorrelationPotential.hpp"
 #include "MBPT/GreenMatrix.hpp"
+#include "MBPT/TensorProduct.hpp"
 #include "Maths/Grid.hpp"
 #include "Maths/LinAlg_MatrixVector.hpp"
 #include "qip/Vector.hpp"
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <numeric>
 #include <optional>
 
@@ -39,9 +41,11 @@ FeynmanSigma::FeynmanSigma(const HF::HartreeFock *const in_hf,
     : CorrelationPotential(in_hf, basis, sigp, subgridp),
       m_screen_Coulomb(sigp.screenCoulomb),
       m_holeParticle(sigp.holeParticle),
+      m_single_precision(sigp.single_precision),
       m_omre(sigp.real_omega),
       m_w0(sigp.w0),
       m_w_ratio(sigp.w_ratio),
+      m_omega_tol(sigp.omega_tol),
       m_Green_method(sigp.GreenBasis ? GrMethod::basis : GrMethod::Green),
       m_Pol_method(sigp.PolBasis ? GrMethod::basis : GrMethod::Green),
       p_hf(in_hf),
@@ -67,20 +71,7 @@ FeynmanSigma::FeynmanSigma(const HF::HartreeFock *const in_hf,
 }
 
 //******************************************************************************
-void FeynmanSigma::formSigma(int kappa, double en, int n) {
-  // Calc dir + exchange
-  // Print D, X, (D+X) energy shift
-  // Add (D+X) to m_Sigma, and (n,k) to lookup_list
-  // most of this is the same between each...?
-
-  // already exists:
-  const auto index = getSigmaIndex(n, kappa);
-  if (index < m_Sigma_kappa.size()) {
-    const auto [n2, k2, en2] = m_nk[index];
-    // already have this (exact) potential?
-    if (n == n2)
-      return;
-  }
+void FeynmanSigma::prep_Sigma() {
   // XXX Need to read/write QPQ etc!!! for this to work ?
   // Temporary solution:
   if (m_qpq_wk.size() == 0) {
@@ -94,68 +85,80 @@ void FeynmanSigma::formSigma(int kappa, double en, int n) {
            "is included will result in incorrect results! Calculate Sigma "
            "first (without Breit), then you may include Breit\n";
   }
+}
 
-  m_nk.emplace_back(n, kappa, en);
-  auto &Sigma = m_Sigma_kappa.emplace_back(m_subgrid_points, m_include_G);
-
-  // if v.kappa > basis, then Ck angular factor won't exist!
-  if (Angular::twoj_k(kappa) > m_yeh.Ck().max_tj()) {
-    std::cout << "Warning: angular not good\n";
-    return;
-  }
+//******************************************************************************
+std::pair<GMatrix, GMatrix>
+FeynmanSigma::calculate_Sigma(int kappa, double en, int n) const {
+  // Calc dir + exchange
+  // nb: prep_Sigma() must have been called first
+  // Each is read from checkpoint file if available; else calculated + written
 
-  printf("k=%2i at en=%8.5f.. ", kappa, en);
-  std::cout << std::flush;
+  const auto id = std::to_string(n) + "_" + std::to_string(kappa);
+  auto key = checkpoint_key();
+  key.insert(key.end(), {double(n), double(kappa), en});
 
-  // find lowest excited state, output <v|S|v> energy shift:
-  const auto find_kappa = [kappa, n](const auto &a) {
-    return a.k == kappa && (a.n == n || n == 0);
-  };
-  const auto vk = std::find_if(cbegin(m_excited), cend(m_excited), find_kappa);
+  GMatrix Sigma(m_subgrid_points, m_include_G);
+  if (!read_checkpoint("direct_" + id, key, &Sigma)) {
+    if (m_print_each_k) {
+      // TEMPORARY: Print each k for direct part: for testing
+      // find lowest excited state, output <v|S|v> energy shift:
+      const auto vk =
+          std::find_if(cbegin(m_excited), cend(m_excited),
+                       [kappa](const auto &a) { return a.k == kappa; });
+      std::cout << "\n";
+      Sigma.zero();
+      const auto max_k = std::min(m_maxk, m_k_cut);
+      for (int k = 0; k <= max_k; ++k) {
+        const auto Sigma_k = FeynmanDirect(kappa, en, k);
+
+        // Print out the direct energy shift:
+        if (vk != cend(m_excited)) {
+          const auto deD = *vk * act_G_Fv(Sigma_k, *vk);
+          printf(" k=%i de(k)=%9.3f \n", k, deD * PhysConst::Hartree_invcm);
+          std::cout << std::flush;
+        }
 
-  // Exchange part:
-  if (m_print_each_k) {
-    // TEMPORARY: Print each k for direct part: for testing
-    std::cout << "\n";
-    const auto max_k = std::min(m_maxk, m_k_cut);
-    for (int k = 0; k <= max_k; ++k) {
-      const auto Sigma_k = FeynmanDirect(kappa, en, k);
-
-      // Print out the direct energy shift:
-      if (vk != cend(m_excited)) {
-        const auto deD = *vk * act_G_Fv(Sigma_k, *vk);
-        printf(" k=%i de(k)=%9.3f \n", k, deD * PhysConst::Hartree_invcm);
-        std::cout << std::flush;
+        Sigma += Sigma_k;
       }
-
-      Sigma += Sigma_k;
+    } else {
+      Sigma = FeynmanDirect(kappa, en);
     }
-  } else {
-    Sigma = FeynmanDirect(kappa, en);
+    write_checkpoint("direct_" + id, key, Sigma);
   }
 
   // Exchange part:
-  const auto Gmat_X = m_ex_method == ExchangeMethod::none
-                          ? 0.0 * Sigma
-                          : m_ex_method == ExchangeMethod::Goldstone
-                                ? Exchange_Goldstone(kappa, en)
-                                : m_ex_method == ExchangeMethod::w1
-                                      ? FeynmanEx_1(kappa, en)
-                                      : FeynmanEx_w1w2(kappa, en);
-
-  // Print energy shifts:
-  if (vk != cend(m_excited)) {
-    auto deD = *vk * act_G_Fv(Sigma, *vk);
-    auto deX = *vk * act_G_Fv(Gmat_X, *vk);
-    // nb: just approximate (uses splines)
-    printf("de= %7.1f + %5.1f = ", deD * PhysConst::Hartree_invcm,
-           deX * PhysConst::Hartree_invcm);
-    printf("%7.1f", (deD + deX) * PhysConst::Hartree_invcm);
+  key.push_back(double(m_ex_method));
+  GMatrix Gmat_X(m_subgrid_points, m_include_G);
+  if (!read_checkpoint("exchange_" + id, key, &Gmat_X)) {
+    Gmat_X = m_ex_method == ExchangeMethod::none
+                 ? 0.0 * Sigma
+                 : m_ex_method == ExchangeMethod::Goldstone
+                       ? Exchange_Goldstone(kappa, en)
+                       : m_ex_method == ExchangeMethod::w1
+                             ? FeynmanEx_1(kappa, en)
+                             : FeynmanEx_w1w2(kappa, en);
+    write_checkpoint("exchange_" + id, key, Gmat_X);
   }
 
-  Sigma += Gmat_X;
+  return {std::move(Sigma), std::move(Gmat_X)};
+}
 
-  std::cout << "\n";
+//******************************************************************************
+std::vector<double> FeynmanSigma::checkpoint_key() const {
+  // Parameters that define the Feynman calculation (for checkpoints)
+  return {m_omre,
+          m_w0,
+          m_w_ratio,
+          m_omega_tol,
+          double(m_screen_Coulomb),
+          double(m_holeParticle),
+          double(m_Green_method),
+          double(m_Pol_method),
+          double(m_min_core_n),
+          double(m_max_kappaindex),
+          double(std::min(m_maxk, m_k_cut)),
+          double(m_single_precision)};
 }
 
 //******************************************************************************
@@ -174,6 +177,9 @@ void FeynmanSigma::prep_Feynman() {
   if (!m_screen_Coulomb && !m_holeParticle)
     std::cout << "Second-order Feynman\n";
 
+  if (m_single_precision)
+    std::cout << "Storing intermediate matrices in single precision\n";
+
   std::cout << "lmax = " << Angular::lFromIndex(m_max_kappaindex) << "\n";
   std::cout << "Using " << ParseEnum(m_Green_method)
             << " method for Green's functions\n";
@@ -214,7 +220,55 @@ void FeynmanSigma::prep_Feynman() {
   print_subGrid();
 
   const auto max_k = std::min(m_maxk, m_k_cut);
-  m_qpq_wk = form_QPQ_wk(max_k, m_Pol_method, m_omre, *m_wgridD);
+  if (!rw_QPQ_checkpoint(IO::FRW::read)) {
+    m_qpq_wk.clear();
+    if (m_omega_tol > 0.0) {
+      adapt_omega_grid();
+    } else {
+      m_wstride_k.assign(std::size_t(max_k + 1), 1);
+      form_QPQ_wk(&m_qpq_wk, m_Pol_method, m_omre, *m_wgridD, m_wstride_k);
+    }
+    rw_QPQ_checkpoint(IO::FRW::write);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool FeynmanSigma::rw_QPQ_checkpoint(IO::FRW::RoW rw) {
+  auto key = checkpoint_key();
+  key.insert(key.end(), {double(m_wgridD->num_points), m_wgridD->r.back()});
+  std::fstream iofs;
+  if (!open_checkpoint(iofs, "qpq", key, rw))
+    return false;
+
+  if (rw == IO::FRW::read)
+    std::cout << "Reading QPQ(w,k) from checkpoint.. " << std::flush;
+  // Im(w) sub-grid used for each k, and exchange (if adaptive)
+  rw_binary(iofs, rw, m_wstride_k, m_wX_stride);
+  std::size_t num_w = m_qpq_wk.size();
+  rw_binary(iofs, rw, num_w);
+  if (rw == IO::FRW::read)
+    m_qpq_wk.resize(num_w);
+  for (auto &qpq_k : m_qpq_wk) {
+    std::size_t num_k = qpq_k.size();
+    rw_binary(iofs, rw, num_k);
+    if (rw == IO::FRW::read)
+      qpq_k.resize(num_k);
+    for (auto &qpq : qpq_k) {
+      qpq.rw(iofs, rw);
+    }
+  }
+
+  if (rw == IO::FRW::write) {
+    commit_checkpoint(iofs, "qpq");
+    return true;
+  }
+  const bool ok = iofs.good() && num_w == m_wgridD->num_points &&
+                  m_wstride_k.size() ==
+                      std::size_t(std::min(m_maxk, m_k_cut) + 1);
+  std::cout << (ok ? "done\n" : "failed\n");
+  if (!ok)
+    m_qpq_wk.clear();
+  return ok;
 }
 
 //------------------------------------------------------------------------------
@@ -542,18 +596,10 @@ ComplexGMatrix FeynmanSigma::Green_hf_basis(int kappa, ComplexDouble en,
 }
 
 //------------------------------------------------------------------------------
-ComplexGMatrix FeynmanSigma::Green_hf(int kappa, ComplexDouble en,
-                                      const DiracSpinor *Fc_hp,
-                                      int k_hp) const {
+GMatrix FeynmanSigma::Green_G0(int kappa, double en_re,
+                               const DiracSpinor *Fc_hp, int k_hp) const {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
 
-  /*
-NOTE: k_hp is "dodgy" parameter.
-For including hole-particle interaction:
-the 'local' method works best for most k's, but the matrix method (with [1-P])
-works better for k=0 (and k>=5 ?)
-  */
-
   // Solve DE (no exchange), regular at 0, infinity ("pinf")
   DiracSpinor x0(0, kappa, p_gr);
   DiracSpinor xI(0, kappa, p_gr);
@@ -568,8 +614,8 @@ works better for k=0 (and k>=5 ?)
     qip::compose(std::minus{}, &vl, y0cc);
   }
 
-  DiracODE::regularAtOrigin(x0, en.re(), vl, Hmag, alpha);
-  DiracODE::regularAtInfinity(xI, en.re(), vl, Hmag, alpha);
+  DiracODE::regularAtOrigin(x0, en_re, vl, Hmag, alpha);
+  DiracODE::regularAtInfinity(xI, en_re, vl, Hmag, alpha);
 
   // Evaluate Wronskian at ~65% of the way to pinf. Should be inependent of r
   const auto pp = std::size_t(0.65 * double(xI.pinf));
@@ -577,7 +623,24 @@ works better for k=0 (and k>=5 ?)
   const auto w = -1.0 * (xI.f[pp] * x0.g[pp] - x0.f[pp] * xI.g[pp]) / alpha;
 
   // Get G0 (Green's function, without exchange):
-  const auto g0 = MakeGreensG0(x0, xI, w);
+  return MakeGreensG0(x0, xI, w);
+}
+
+//------------------------------------------------------------------------------
+ComplexGMatrix FeynmanSigma::Green_hf(int kappa, ComplexDouble en,
+                                      const DiracSpinor *Fc_hp,
+                                      int k_hp) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
+  /*
+NOTE: k_hp is "dodgy" parameter.
+For including hole-particle interaction:
+the 'local' method works best for most k's, but the matrix method (with [1-P])
+works better for k=0 (and k>=5 ?)
+  */
+
+  // G0 depends only on real part of energy
+  const auto g0 = Green_G0(kappa, en.re(), Fc_hp, k_hp);
   auto Vx = get_Vx_kappa(kappa);
 
   if (Fc_hp != nullptr && k_hp == 0) {
@@ -607,6 +670,30 @@ works better for k=0 (and k>=5 ?)
          (one * g0);
 }
 
+//------------------------------------------------------------------------------
+std::optional<ComplexGMatrix>
+FeynmanSigma::Green_hf_real(int kappa, double en_re) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  // G = [1 - G0*Vx]^{-1} * G0 = -[G0*Vx-1]^{-1} * G0 ; all real
+  const auto g0 = Green_G0(kappa, en_re);
+  const auto &Vx = get_Vx_kappa(kappa);
+  auto a = g0 * Vx;
+  a.plusIdent(-1.0);
+  const auto a_inv = a.inverse();
+
+  // Near a HF eigenvalue, [G0*Vx-1] is (near) singular, and G(e_r) is huge;
+  // G(e_r+iw) = [1 + iw*G(e_r)]^{-1} * G(e_r) then loses all precision.
+  // Rough condition number estimate (within factor of ~dimension):
+  // cond(A) ~ max|A_ij| * max|A^-1_ij|. If too large, caller must use Green_hf
+  const auto cond =
+      std::abs(a.max_el().first) * std::abs(a_inv.max_el().first);
+  if (!std::isfinite(cond) || cond > 1.0e8)
+    return std::nullopt;
+
+  const ComplexDouble one{1.0, 0.0};
+  return (-1 * one) * (a_inv * g0);
+}
+
 //------------------------------------------------------------------------------
 ComplexGMatrix FeynmanSigma::GreenAtComplex(const ComplexGMatrix &Gr,
                                             double om_imag) const {
@@ -707,59 +794,176 @@ ComplexGMatrix FeynmanSigma::X_PiQ(const ComplexGMatrix &pik,
 }
 
 //******************************************************************************
-std::vector<std::vector<ComplexGMatrix>>
-FeynmanSigma::make_pi_wk(int max_k, GrMethod pol_method, double omre,
-                         const Grid &wgrid) const {
+void FeynmanSigma::form_QPQ_wk(
+    std::vector<std::vector<PackedComplexGMatrix>> *qpq, GrMethod pol_method,
+    double omre, const Grid &wgrid,
+    const std::vector<std::size_t> &wstride_k) const {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+  // Forms QPQ, function of w and k, for each k at every wstride_k[k]-th w
+  // (k skipped if wstride_k[k]=0). Existing (non-empty) entries are kept.
+  // Pi^k(w) formed here as needed (not stored); QPQ stored in single
+  // precision if m_single_precision is set
+
+  const auto num_ks = wstride_k.size();
+  qpq->resize(wgrid.num_points);
+  for (auto &qpq_w : *qpq)
+    qpq_w.resize(num_ks);
+  std::cout << "Forming QPQ(w,k) matrix.." << std::flush;
 
-  const auto num_ks = std::size_t(max_k + 1);
-  std::vector<std::vector<ComplexGMatrix>> pi_wk(wgrid.num_points);
+  // For accuracy report (single precision): largest relative rounding error
+  double max_eps = 0.0;
+  std::size_t bytes = 0;
 
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic) reduction(max : max_eps)           \
+    reduction(+ : bytes)
   for (auto iw = 0ul; iw < wgrid.num_points; ++iw) {
     const auto omega = ComplexDouble{omre, wgrid.r[iw]};
-    pi_wk[iw].reserve(num_ks);
     for (auto k = 0ul; k < num_ks; ++k) {
-      pi_wk[iw].push_back(Polarisation_k(int(k), omega, pol_method));
+      auto &packed = (*qpq)[iw][k];
+      if (wstride_k[k] == 0 || iw % wstride_k[k] != 0 || !packed.empty())
+        continue;
+      // q*p*q => q*X*p*q, x = [1-Pi*Q]^(-1)
+      const auto &qk = get_qk(int(k));
+      const auto pi = Polarisation_k(int(k), omega, pol_method);
+      auto qpq_wk = m_screen_Coulomb ? qk * X_PiQ(pi, qk) * pi * qk
+                                     : qk * pi * qk;
+      if (m_single_precision) {
+        packed = PackedComplexGMatrix(qpq_wk, true);
+        max_eps = std::max(max_eps, packed.rel_error(qpq_wk));
+      } else {
+        packed = PackedComplexGMatrix(std::move(qpq_wk), false);
+      }
+      bytes += packed.bytes();
     }
   }
-  return pi_wk;
+  std::cout << "..done\n";
+  if (m_single_precision) {
+    printf("QPQ stored in single precision: %.1f MB (vs. %.1f MB); max. "
+           "relative rounding error: %.1e\n",
+           double(bytes) / 1.0e6, 2.0 * double(bytes) / 1.0e6, max_eps);
+  }
 }
 
 //******************************************************************************
-std::vector<std::vector<ComplexGMatrix>>
-FeynmanSigma::form_QPQ_wk(int max_k, GrMethod pol_method, double omre,
-                          const Grid &wgrid) const {
+void FeynmanSigma::adapt_omega_grid() {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
-  // Returns QPQ, function of w and k
-
-  std::vector<std::vector<ComplexGMatrix>> qpq(wgrid.num_points);
-  std::cout << "Forming QPQ(w,k) matrix.." << std::flush;
+  // Chooses, for each k, the coarsest (nested) sub-grid of the Im(w) grid,
+  // (every s-th point, s=2^n) for which the direct Sigma has converged.
+  // Starting from the coarsest grid, the stride is halved (adding the points
+  // in-between) until the change in <v|Sigma^k_dir|v> (for a few "probe"
+  // states) is below m_omega_tol (relative to the total). QPQ is only formed
+  // at the points needed
 
-  const auto pi_wk = make_pi_wk(max_k, pol_method, omre, wgrid);
-  std::cout << "." << std::flush;
+  const auto max_k = std::min(m_maxk, m_k_cut);
+  const auto num_ks = std::size_t(max_k + 1);
+  const auto num_w = m_wgridD->num_points;
+
+  // Coarsest level: at least 4 points
+  std::size_t s0 = 1;
+  while (s0 < 16 && num_w / (2 * s0) >= 4)
+    s0 *= 2;
+
+  // "Probe" states: lowest (basis) s_1/2 and p_1/2 excited states
+  std::vector<const DiracSpinor *> probes;
+  for (const auto kappa : {-1, 1}) {
+    const DiracSpinor *Fv = nullptr;
+    for (const auto &Fn : m_excited) {
+      if (Fn.k == kappa && (Fv == nullptr || Fn.en < Fv->en))
+        Fv = &Fn;
+    }
+    if (Fv != nullptr)
+      probes.push_back(Fv);
+  }
 
-  std::cout << "." << std::flush;
+  m_wstride_k.assign(num_ks, probes.empty() ? 1 : s0);
+  if (probes.empty()) {
+    std::cout << "Adaptive Im(w) grid: no probe states; using full grid\n";
+    form_QPQ_wk(&m_qpq_wk, m_Pol_method, m_omre, *m_wgridD, m_wstride_k);
+    return;
+  }
 
-  const auto num_ks = std::size_t(max_k + 1);
-#pragma omp parallel for
-  for (auto iw = 0ul; iw < wgrid.num_points; ++iw) {
-    qpq[iw].reserve(num_ks);
+  std::cout << "Adaptive Im(w) grid, tolerance: " << m_omega_tol << "\n";
+  std::vector<bool> converged(num_ks, false);
+  // de[p][k] = <p|Sigma^k_dir|p>, for each probe p; at current stride for k
+  std::vector<std::vector<double>> de(probes.size(),
+                                      std::vector<double>(num_ks, 0.0));
+  for (auto s = s0; s >= 1; s /= 2) {
+    std::vector<std::size_t> level(num_ks, 0);
     for (auto k = 0ul; k < num_ks; ++k) {
-      // q*p*q => q*X*p*q, x = [1-Pi*Q]^(-1)
-      const auto &qk = get_qk(int(k));
-      const auto &pi = pi_wk[iw][k];
-      if (m_screen_Coulomb) {
-        // This way: works!
-        const auto X = X_PiQ(pi, qk);
-        qpq[iw].emplace_back(qk * X * pi * qk);
-      } else {
-        qpq[iw].emplace_back(qk * pi * qk);
+      if (!converged[k])
+        level[k] = s;
+    }
+    form_QPQ_wk(&m_qpq_wk, m_Pol_method, m_omre, *m_wgridD, level);
+
+    for (auto ip = 0ul; ip < probes.size(); ++ip) {
+      const auto &Fv = *probes[ip];
+      const auto Sigma_k = FeynmanDirect_k(Fv.k, Fv.en, level);
+      const auto de_tot = std::accumulate(cbegin(de[ip]), cend(de[ip]), 0.0);
+      for (auto k = 0ul; k < num_ks; ++k) {
+        if (level[k] == 0)
+          continue;
+        const auto de_k = Fv * act_G_Fv(Sigma_k[k], Fv);
+        // Can't test convergence on the first (coarsest) level
+        const auto ok = s != s0 && std::abs(de_k - de[ip][k]) <
+                                       m_omega_tol * std::abs(de_tot);
+        // converged only if converged for all probes
+        if (ip == 0)
+          converged[k] = ok;
+        else
+          converged[k] = converged[k] && ok;
+        de[ip][k] = de_k;
       }
     }
+
+    for (auto k = 0ul; k < num_ks; ++k) {
+      if (level[k] != 0)
+        m_wstride_k[k] = s;
+    }
+    if (std::all_of(cbegin(converged), cend(converged),
+                    [](bool c) { return c; }))
+      break;
   }
-  std::cout << "..done\n";
-  return qpq;
+
+  std::cout << "Im(w) points used for each k:\n";
+  for (auto k = 0ul; k < num_ks; ++k) {
+    const auto s = m_wstride_k[k];
+    printf(" k=%lu: %3lu/%lu (stride %lu)\n", k, (num_w + s - 1) / s, num_w,
+           s);
+  }
+
+  // Exchange: same test, for the Im(w)-grid exchange methods (Goldstone
+  // exchange does not use the Im(w) grid). Stride is halved until the change
+  // in <v|Sigma_x|v> is below m_omega_tol (relative to total: direct+exchange)
+  m_wX_stride = 1;
+  if (m_ex_method != ExchangeMethod::w1 && m_ex_method != ExchangeMethod::w1w2)
+    return;
+  std::vector<double> deX(probes.size(), 0.0);
+  for (auto s = s0; s >= 1; s /= 2) {
+    m_wX_stride = s;
+    if (m_screen_Coulomb && m_ex_method == ExchangeMethod::w1) {
+      // Screened exchange requires QPQ for all k at the exchange points
+      form_QPQ_wk(&m_qpq_wk, m_Pol_method, m_omre, *m_wgridD,
+                  std::vector<std::size_t>(num_ks, s));
+    }
+    // Can't test convergence on the first (coarsest) level
+    bool converged_x = s != s0;
+    for (auto ip = 0ul; ip < probes.size(); ++ip) {
+      const auto &Fv = *probes[ip];
+      const auto Sigma_x = m_ex_method == ExchangeMethod::w1
+                               ? FeynmanEx_1(Fv.k, Fv.en)
+                               : FeynmanEx_w1w2(Fv.k, Fv.en);
+      const auto de_x = Fv * act_G_Fv(Sigma_x, Fv);
+      const auto de_tot =
+          std::accumulate(cbegin(de[ip]), cend(de[ip]), 0.0) + de_x;
+      converged_x = converged_x &&
+                    std::abs(de_x - deX[ip]) < m_omega_tol * std::abs(de_tot);
+      deX[ip] = de_x;
+    }
+    if (converged_x)
+      break;
+  }
+  printf(" exchange: %3lu/%lu (stride %lu)\n",
+         (num_w + m_wX_stride - 1) / m_wX_stride, num_w, m_wX_stride);
 }
 
 //******************************************************************************
@@ -769,15 +973,43 @@ FeynmanSigma::form_Greens_kapw(int max_kappa_index, GrMethod method,
   // G(en_re+iw) for each kappa, w
   // nb: en_re = en_v + omre
 
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
   const auto num_kappas = std::size_t(max_kappa_index + 1);
-  std::vector<std::vector<ComplexGMatrix>> gs(num_kappas);
+  if (method != GrMethod::Green) {
+    std::vector<std::vector<ComplexGMatrix>> gs(num_kappas);
+#pragma omp parallel for
+    for (auto ik = 0ul; ik < num_kappas; ++ik) {
+      const auto kappa = Angular::kappaFromIndex(int(ik));
+      gs[ik].reserve(wgrid.num_points);
+      for (auto iw = 0ul; iw < wgrid.num_points; iw++) {
+        ComplexDouble evpw{en_re, wgrid.r[iw]};
+        gs[ik].push_back(Green(kappa, evpw, States::both, method));
+      }
+    }
+    return gs;
+  }
+
+  // The homogeneous solutions (and hence G0, and the exchange correction)
+  // depend only on the real part of the energy, which is the same for every w.
+  // So, G(en_re) is found just once per kappa (real arithmetic); then
+  // G(en_re + iw) = [1 + iw*G(en_re)]^{-1} * G(en_re) for each w.
+  // If G(en_re) is near-singular (empty), G(en_re + iw) is found directly
+  std::vector<std::optional<ComplexGMatrix>> grs(num_kappas);
 #pragma omp parallel for
   for (auto ik = 0ul; ik < num_kappas; ++ik) {
-    const auto kappa = Angular::kappaFromIndex(int(ik));
-    gs[ik].reserve(wgrid.num_points);
+    grs[ik] = Green_hf_real(Angular::kappaFromIndex(int(ik)), en_re);
+  }
+
+  std::vector<std::vector<ComplexGMatrix>> gs(
+      num_kappas, std::vector<ComplexGMatrix>(
+                      wgrid.num_points, {m_subgrid_points, m_include_G}));
+#pragma omp parallel for collapse(2)
+  for (auto ik = 0ul; ik < num_kappas; ++ik) {
     for (auto iw = 0ul; iw < wgrid.num_points; iw++) {
-      ComplexDouble evpw{en_re, wgrid.r[iw]};
-      gs[ik].push_back(Green(kappa, evpw, States::both, method));
+      const auto kappa = Angular::kappaFromIndex(int(ik));
+      gs[ik][iw] = grs[ik] ? GreenAtComplex(*grs[ik], wgrid.r[iw])
+                           : Green(kappa, {en_re, wgrid.r[iw]});
     }
   }
   return gs;
@@ -787,46 +1019,99 @@ FeynmanSigma::form_Greens_kapw(int max_kappa_index, GrMethod method,
 //******************************************************************************
 
 //******************************************************************************
-GMatrix FeynmanSigma::FeynmanDirect(int kv, double env, int in_k) const {
+GMatrix FeynmanSigma::FeynmanDirect(int kv, double env, int in_k,
+                                    bool G_from_real) const {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
 
   /* TEMPORARY: in_k ionly for testing; useful for comparing to Dzuba
    * though..*/
 
+  // Each k uses its own Im(w) sub-grid (see adapt_omega_grid)
+  auto wstride_k = m_wstride_k;
+  for (auto k = 0ul; k < wstride_k.size(); ++k) {
+    if (in_k >= 0 && in_k != int(k))
+      wstride_k[k] = 0;
+  }
+
+  const auto Sigma_k = FeynmanDirect_k(kv, env, wstride_k, G_from_real);
   GMatrix Sigma(m_subgrid_points, m_include_G);
+  for (const auto &Sk : Sigma_k)
+    Sigma += Sk;
+  return Sigma;
+}
+
+//------------------------------------------------------------------------------
+std::vector<GMatrix>
+FeynmanSigma::FeynmanDirect_k(int kv, double env,
+                              const std::vector<std::size_t> &wstride_k,
+                              bool G_from_real) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
+  const auto num_ks = wstride_k.size();
+  std::vector<GMatrix> Sigma(num_ks, {m_subgrid_points, m_include_G});
 
   const ComplexDouble I{0.0, 1.0};
 
   // // Set up imaginary frequency grid:
   const double omre = m_omre;
   const auto &wgrid = *m_wgridD;
-  const auto max_k = std::min(m_maxk, m_k_cut);
 
-  // Store gAs in advance
+  // Only need G at points used for at least one k
+  std::vector<bool> w_used(wgrid.num_points, false);
+  for (auto iw = 0ul; iw < wgrid.num_points; iw++) {
+    for (const auto s : wstride_k) {
+      if (s != 0 && iw % s == 0)
+        w_used[iw] = true;
+    }
+  }
+
+  // Store gBs in advance (in single precision if m_single_precision)
   const auto num_kappas = std::size_t(m_max_kappaindex + 1);
-  const auto gBs =
-      form_Greens_kapw(m_max_kappaindex, m_Green_method, env + omre, wgrid);
+  std::vector<std::vector<PackedComplexGMatrix>> gBs(
+      num_kappas, std::vector<PackedComplexGMatrix>(wgrid.num_points));
+#pragma omp parallel for
+  for (auto iB = 0ul; iB < num_kappas; ++iB) {
+    const auto kB = Angular::kappaFromIndex(int(iB));
+    // G(e_r) found once; G(e_r + iw) from G(e_r), without re-solving DE
+    // (unless G(e_r) is near-singular: then found directly at each w)
+    const auto gBr = G_from_real && m_Green_method == GrMethod::Green
+                         ? Green_hf_real(kB, env + omre)
+                         : std::nullopt;
+    for (auto iw = 0ul; iw < wgrid.num_points; iw++) {
+      if (!w_used[iw])
+        continue;
+      const ComplexDouble evpw{env + omre, wgrid.r[iw]};
+      gBs[iB][iw] = PackedComplexGMatrix(
+          gBr ? GreenAtComplex(*gBr, wgrid.r[iw])
+              : Green(kB, evpw, States::both, m_Green_method),
+          m_single_precision);
+    }
+  }
 
   // If Im(w) grid is -ve, we integrate "wrong" way around contour; extra -ve
   const auto sw = wgrid.r[0] > 0.0 ? 1.0 : -1.0;
 
 #pragma omp parallel for
   for (auto iw = 0ul; iw < wgrid.num_points; iw++) { // for omega integral
+    if (!w_used[iw])
+      continue;
 
-    // Simpson's rule: Implicit ends (integrand zero at w=0 and w>wmax)
-    const auto weight = iw % 2 == 0 ? 4.0 / 3 : 2.0 / 3;
-
-    // I, since dw is on imag. grid; 2 from symmetric +/- w
-    const auto dw = I * weight * wgrid.drdu[iw];
-
-    for (auto k = 0ul; int(k) <= max_k; k++) {
+    // Contribution from this w (accumulated in double)
+    GMatrix Sigma_w(m_subgrid_points, m_include_G);
 
-      // For testing only:
-      if (in_k >= 0 && in_k != int(k))
+    for (auto k = 0ul; k < num_ks; k++) {
+      const auto stride = wstride_k[k];
+      if (stride == 0 || iw % stride != 0)
         continue;
 
-      const auto qpq_dw = dw * m_qpq_wk[iw][k];
+      // Simpson's rule: Implicit ends (integrand zero at w=0 and w>wmax)
+      // On sub-grid (every stride-th point), du -> stride*du
+      const auto weight = (iw / stride) % 2 == 0 ? 4.0 / 3 : 2.0 / 3;
+
+      // I, since dw is on imag. grid; 2 from symmetric +/- w
+      const auto dw = I * weight * double(stride) * wgrid.drdu[iw];
 
+      Sigma_w.zero();
       for (auto iB = 0ul; iB < num_kappas; ++iB) {
         const auto kB = Angular::kappaFromIndex(int(iB));
         const auto ck_vB = Angular::Ck_kk(int(k), kv, kB);
@@ -834,37 +1119,39 @@ GMatrix FeynmanSigma::FeynmanDirect(int kv, double env, int in_k) const {
           continue;
 
         const auto c_ang = ck_vB * ck_vB / double(Angular::twoj_k(kv) + 1);
-        const auto C_gB_QPQ_dw =
-            c_ang * (mult_elements(gBs[iB][iw], qpq_dw)).get_real();
+        // Sigma_w += c_ang * Re[dw * gB .* qpq] (element-wise)
+        add_Re_product(&Sigma_w, c_ang * dw, gBs[iB][iw], m_qpq_wk[iw][k]);
 
-#pragma omp critical(sum_sigma_d)
-        { Sigma += C_gB_QPQ_dw; }
+      } // beta
 
-      } // k
-    }   // omega
-  }     // beta
+#pragma omp critical(sum_sigma_d)
+      { Sigma[k] += Sigma_w; }
+    } // k
+  }   // omega
 
-  // Extra 2 from symmetric + / -w
-  Sigma *= (2.0 * sw * wgrid.du / (2 * M_PI));
+  for (auto &Sigma_k : Sigma) {
+    // Extra 2 from symmetric + / -w
+    Sigma_k *= (2.0 * sw * wgrid.du / (2 * M_PI));
 
-  // devide through by dri, drj [these included in q's, but want
-  // differential operator for sigma] or.. include one of these in
-  // definition of opertion S|v> ?
-  for (auto i = 0ul; i < m_subgrid_points; ++i) {
-    const auto dri = dr_subToFull(i);
-    for (auto j = 0ul; j < m_subgrid_points; ++j) {
-      const auto drj = dr_subToFull(j);
-      Sigma.ff[i][j] /= (dri * drj);
-      if (m_include_G) {
-        Sigma.fg[i][j] /= (dri * drj);
-        Sigma.gf[i][j] /= (dri * drj);
-        Sigma.gg[i][j] /= (dri * drj);
+    // devide through by dri, drj [these included in q's, but want
+    // differential operator for sigma] or.. include one of these in
+    // definition of opertion S|v> ?
+    for (auto i = 0ul; i < m_subgrid_points; ++i) {
+      const auto dri = dr_subToFull(i);
+      for (auto j = 0ul; j < m_subgrid_points; ++j) {
+        const auto drj = dr_subToFull(j);
+        Sigma_k.ff[i][j] /= (dri * drj);
+        if (m_include_G) {
+          Sigma_k.fg[i][j] /= (dri * drj);
+          Sigma_k.gf[i][j] /= (dri * drj);
+          Sigma_k.gg[i][j] /= (dri * drj);
+        }
       }
     }
   }
 
   return Sigma;
-} // namespace MBPT
+}
 
 //******************************************************************************
 GMatrix FeynmanSigma::FeynmanEx_w1w2(int kv, double en_r) const {
@@ -1027,8 +1314,10 @@ GMatrix FeynmanSigma::FeynmanEx_1(int kv, double env) const {
   // // const std::size_t num_para_threads = 12;
   // const std::size_t num_para_threads =
   //     use_omp ? num_kappas * wgrid.num_points / m_wX_stride / 4 : 1;
+  // Parallel over w; QPQ(w) (if stored in single precision) is unpacked once
+  // per w, outside the kappa_B loop
   const std::size_t num_para_threads =
-      use_omp ? std::min(num_kappas * wgrid.num_points / m_wX_stride,
+      use_omp ? std::min(wgrid.num_points / m_wX_stride,
                          std::size_t(4 * omp_get_max_threads()))
               : 1;
 
@@ -1036,22 +1325,37 @@ GMatrix FeynmanSigma::FeynmanEx_1(int kv, double env) const {
 
   const auto wmax = 100.0; // XXX Temp?
 
-// #pragma omp parallel for collapse(2)
-#pragma omp parallel for num_threads(num_para_threads) collapse(2)
-  for (auto iB = 0ul; iB < num_kappas; ++iB) {
-    for (auto iw = 0ul; iw < wgrid.num_points; iw += m_wX_stride) {
-      const auto kB = Angular::kappaFromIndex(int(iB));
-
-      if (std::abs(wgrid.r[iw]) > wmax)
-        continue;
-
-      const auto tid = std::size_t(omp_get_thread_num());
+#pragma omp parallel for num_threads(num_para_threads) schedule(dynamic)
+  for (auto iw = 0ul; iw < wgrid.num_points; iw += m_wX_stride) {
+    if (std::abs(wgrid.r[iw]) > wmax)
+      continue;
 
-      auto omim = wgrid.r[iw]; // XXX Symmetric?? Or Not??
-      const auto omega = ComplexDouble{omre, omim};
-      const auto dw1 = wgrid.drdu[iw]; // rest in 'factor'
+    const auto tid = std::size_t(omp_get_thread_num());
+
+    auto omim = wgrid.r[iw]; // XXX Symmetric?? Or Not??
+    const auto omega = ComplexDouble{omre, omim};
+    const auto dw1 = wgrid.drdu[iw]; // rest in 'factor'
+
+    // QPQ(w), for each k: stored matrices used directly in double precision;
+    // only unpacked (copied) if stored in single precision
+    std::vector<ComplexGMatrix> qpq_unpacked;
+    std::vector<const ComplexGMatrix *> qpqw;
+    if (m_screen_Coulomb) {
+      if (m_single_precision) {
+        qpq_unpacked.reserve(m_qpq_wk[iw].size());
+        for (const auto &qpq : m_qpq_wk[iw])
+          qpq_unpacked.push_back(qpq.unpack());
+        for (const auto &qpq : qpq_unpacked)
+          qpqw.push_back(&qpq);
+      } else {
+        for (const auto &qpq : m_qpq_wk[iw])
+          qpqw.push_back(qpq.matrix());
+      }
+    }
+    const auto *const qpqw_k = m_screen_Coulomb ? &qpqw : nullptr;
 
-      const auto *const qpqw_k = m_screen_Coulomb ? &m_qpq_wk[iw] : nullptr;
+    for (auto iB = 0ul; iB < num_kappas; ++iB) {
+      const auto kB = Angular::kappaFromIndex(int(iB));
 
       for (auto ia = 0ul; ia < core.size(); ++ia) {
         const auto &Fa = core[ia];
@@ -1113,24 +1417,32 @@ GMatrix FeynmanSigma::sumkl_gqgqg(const ComplexGMatrix &gA,
 
   auto gqgqg = GMatrix(m_subgrid_points, m_include_G);
 
+  const ComplexDouble one{1.0, 0.0};
+
   for (int k = 0; k <= kmax; k++) { // k (k1)
     const auto &qk = get_qk(k);
 
+    // tensor_5_product is linear in e (=ql): so sum over l first.
+    // sum_l [ sLkl * ql ], then only one tensor_5_product per k
+    ComplexGMatrix sum_ql(m_subgrid_points, m_include_G);
+    bool any_l = false;
     for (int l = 0; l <= kmax; l++) { // l (k2)
-      const auto &ql = get_qk(l);
-
-      // tensor_5_product adds the real part of below to result
-      // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
       const auto Lkl = Lkl_abcd(k, l, kv, kB, kA, kG);
       if (Lkl != 0.0) {
         const auto s = Angular::neg1pow(k + l);
         // const auto sLkl = ComplexDouble{s * Lkl, 0.0};
         // // XXX extra factor of i ??: - pretty sure this is wrong
         const auto sLkl = ComplexDouble{0.0, s * Lkl};
-        tensor_5_product(&gqgqg, sLkl, qk, gB, gG, gA, ql);
+        sum_ql += sLkl * get_qk(l);
+        any_l = true;
       }
     } // l
-  }   // k
+
+    // tensor_5_product adds the real part of below to result
+    // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
+    if (any_l)
+      tensor_5_product(&gqgqg, one, qk, gB, gG, gA, sum_ql);
+  } // k
 
   return gqgqg;
 }
@@ -1139,7 +1451,8 @@ GMatrix FeynmanSigma::sumkl_gqgqg(const ComplexGMatrix &gA,
 GMatrix FeynmanSigma::sumkl_GQPGQ(
     const ComplexGMatrix &gA, const ComplexGMatrix &gxBm,
     const ComplexGMatrix &gxBp, const ComplexGMatrix &pa, int kv, int kA,
-    int kB, int ka, const std::vector<ComplexGMatrix> *const qpqw_k) const {
+    int kB, int ka,
+    const std::vector<const ComplexGMatrix *> *const qpqw_k) const {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
   // EXCHANGE part, used in w1 version
   // (w2 was integrated over analytically)
@@ -1154,8 +1467,12 @@ GMatrix FeynmanSigma::sumkl_GQPGQ(
     const auto &tqk = get_qk(k);
     // Screen q^k(w1) {not checked}
     const auto qk =
-        qpqw_k != nullptr ? tqk - 2.0 * I * (*qpqw_k)[std::size_t(k)] : tqk;
+        qpqw_k != nullptr ? tqk - 2.0 * I * *(*qpqw_k)[std::size_t(k)] : tqk;
 
+    // tensor_5_product is linear in e (=ql): so sum over l first
+    ComplexGMatrix sum_ql1(m_subgrid_points, m_include_G);
+    ComplexGMatrix sum_ql2(m_subgrid_points, m_include_G);
+    bool any_l1 = false, any_l2 = false;
     for (auto l = 0; l <= kmax; ++l) {
       const auto &ql = get_qk(l);
 
@@ -1164,58 +1481,26 @@ GMatrix FeynmanSigma::sumkl_GQPGQ(
       const auto L1 = Lkl_abcd(k, l, kv, kB, kA, ka);
       const auto L2 = Lkl_abcd(k, l, kv, ka, kA, kB);
 
-      const auto ic1 = ComplexDouble(s0 * L1, 0.0);
-      const auto ic2 = ComplexDouble(s0 * L2, 0.0);
-
-      // tensor_5_product adds the real part of below to result
-      // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
-
-      if (L1 != 0.0)
-        tensor_5_product(&sum_GQPG, ic1, qk, gxBp, pa, gA, ql);
-
-      if (L2 != 0.0)
-        tensor_5_product(&sum_GQPG, ic2, qk, pa, gxBm, gA, ql);
-
-    } // l
-  }   // k
-
-  return sum_GQPG;
-}
-
-//******************************************************************************
-void FeynmanSigma::tensor_5_product(
-    GMatrix *result, const ComplexDouble &factor, const ComplexGMatrix &a,
-    const ComplexGMatrix &b, const ComplexGMatrix &c, const ComplexGMatrix &d,
-    const ComplexGMatrix &e) const {
-  // Adds real part of below to result
-  // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
-  const auto size = result->size;
-
-  // The a*c part depends only on j (not i).
-  // Doing this mult early saves factor of 'size' complex multiplications
-  // Leads to a >2x speed-up!
-  std::vector<ComplexDouble> ac(size); // see below
-
-  for (auto r1 = 0ul; r1 < size; ++r1) {
-    for (auto r2 = 0ul; r2 < size; ++r2) {
-
-      for (auto j = 0ul; j < size; ++j) {
-        // early a*c mult
-        // Note: a and c are actually real (only half the time..)
-        ac[j] = ComplexDouble(a.ff[r1][j]) * c.ff[j][r2];
+      if (L1 != 0.0) {
+        sum_ql1 += (s0 * L1) * ql;
+        any_l1 = true;
       }
-      ComplexDouble sum_ij{0.0, 0.0};
-      for (auto i = 0ul; i < size; ++i) {
-        ComplexDouble sum_j{0.0, 0.0};
-        for (auto j = 0ul; j < size; ++j) {
-          sum_j += ac[j] * b.ff[i][j];
-        }
-        sum_ij += sum_j * d.ff[r1][i] * e.ff[i][r2];
+      if (L2 != 0.0) {
+        sum_ql2 += (s0 * L2) * ql;
+        any_l2 = true;
       }
-      result->ff[r1][r2] += (factor * sum_ij).cre();
+    } // l
 
-    } // r2
-  }   // r1
+    // tensor_5_product adds the real part of below to result
+    // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
+    const ComplexDouble one{1.0, 0.0};
+    if (any_l1)
+      tensor_5_product(&sum_GQPG, one, qk, gxBp, pa, gA, sum_ql1);
+    if (any_l2)
+      tensor_5_product(&sum_GQPG, one, qk, pa, gxBm, gA, sum_ql2);
+  } // k
+
+  return sum_GQPG;
 }
 
 //******************************************************************************
@@ -2,7 +2,9 @@
 #include "CorrelationPotential.hpp"
 #include "Maths/Grid.hpp"
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 // class Grid;
 namespace HF {
@@ -55,9 +57,11 @@ public:
   FeynmanSigma(const FeynmanSigma &) = delete;
   ~FeynmanSigma() = default;
 
-  void formSigma(int kappa, double en, int n = 0) override final;
-
 protected:
+  void prep_Sigma() override final;
+  std::pair<GMatrix, GMatrix> calculate_Sigma(int kappa, double en,
+                                              int n) const override final;
+
 public:
   //!@brief
   // Calculates (radial) Hartree-Fock Greens function G_kappa(er + i*ei).
@@ -71,6 +75,12 @@ public:
   [[nodiscard]] ComplexGMatrix GreenAtComplex(const ComplexGMatrix &Gr,
                                               double e_imag) const;
 
+  //! Hartree-Fock Green function (including exchange), for real en. Returns
+  //! empty if [1 - G0*Vx] is near-singular (en close to a HF eigenvalue): then
+  //! G(en + iw) must be found directly (Green), not via GreenAtComplex
+  [[nodiscard]] std::optional<ComplexGMatrix> Green_hf_real(int kappa,
+                                                            double en_re) const;
+
   //! Calculates radial polarisation operator
   [[nodiscard]] ComplexGMatrix Polarisation_k(int k, ComplexDouble omega,
                                               GrMethod method) const;
@@ -84,8 +94,16 @@ public:
   [[nodiscard]] const ComplexGMatrix &get_dri() const { return *m_dri; }
   [[nodiscard]] const ComplexGMatrix &get_drj() const { return *m_drj; }
 
-  //! Calculates direct Sigma using Feynman method
-  [[nodiscard]] GMatrix FeynmanDirect(int kv, double env, int k = -1) const;
+  //! Calculates direct Sigma using Feynman method. If G_from_real (default),
+  //! G(e_r + iw) is found from G(e_r) [Green_hf_real]; else by direct complex
+  //! inversion at each w
+  [[nodiscard]] GMatrix FeynmanDirect(int kv, double env, int k = -1,
+                                      bool G_from_real = true) const;
+  //! Direct Sigma, separately for each k. The k-th part uses every
+  //! wstride_k[k]-th Im(w) point (QPQ must exist there); skipped if zero
+  [[nodiscard]] std::vector<GMatrix>
+  FeynmanDirect_k(int kv, double env, const std::vector<std::size_t> &wstride_k,
+                  bool G_from_real = true) const;
 
   [[nodiscard]] GMatrix FeynmanEx_w1w2(int kv, double en) const;
   //! Calculates exchange Sigma using Feynman method [w_1 version]
@@ -99,6 +117,10 @@ public:
 private:
   // Calculates initial data needed for Feynman (|a><a|, w grids etc)
   void prep_Feynman();
+  // Parameters that define the calculation: for checkpoint files
+  std::vector<double> checkpoint_key() const;
+  // Reads/writes QPQ(w,k) checkpoint; for read, returns false if not found
+  bool rw_QPQ_checkpoint(IO::FRW::RoW rw);
   // Calculates + stores the (radial) q^k matrix, for each k (includes dri*drj)
   void form_Q_dr();
   // Calculates and stores radial exchange matrix Vx for each kappa
@@ -123,8 +145,10 @@ private:
   // Force Gk to be orthogonal to the core states
   void makeGOrthogCore(ComplexGMatrix *Gk, int kappa) const;
 
-  // // Calculates Hartree-Fock Green function (including exchange), for real en
-  // [[nodiscard]] ComplexGMatrix Green_hf_real(int kappa, double en) const;
+  // Calculates G0 (no exchange) for real en: solves homogeneous DE
+  [[nodiscard]] GMatrix Green_G0(int kappa, double en_re,
+                                 const DiracSpinor *Fc_hp = nullptr,
+                                 int k_hp = 0) const;
   // Calculates HF Green function (including exchange), for Complex en
   [[nodiscard]] ComplexGMatrix Green_hf(int kappa, ComplexDouble en,
                                         const DiracSpinor *Fc_hp = nullptr,
@@ -142,16 +166,14 @@ private:
   ComplexGMatrix X_PiQ(const ComplexGMatrix &pik,
                        const ComplexGMatrix &qk) const;
 
-  std::vector<std::vector<ComplexGMatrix>> make_pi_wk(int max_k,
-                                                      GrMethod pol_method,
-                                                      double omre,
-                                                      const Grid &wgrid) const;
-
-  // ComplexGMatrix form_QPQ_wk(const ComplexGMatrix &PiQ) const;
-  std::vector<std::vector<ComplexGMatrix>> form_QPQ_wk(int max_k,
-                                                       GrMethod pol_method,
-                                                       double en_re,
-                                                       const Grid &wgrid) const;
+  // Forms QPQ(w,k) for each k, at every wstride_k[k]-th w point (none if
+  // wstride_k[k]=0). Entries already formed (non-empty) are not re-calculated
+  void form_QPQ_wk(std::vector<std::vector<PackedComplexGMatrix>> *qpq,
+                   GrMethod pol_method, double omre, const Grid &wgrid,
+                   const std::vector<std::size_t> &wstride_k) const;
+  // Chooses Im(w) sub-grid for each k (m_wstride_k) adaptively, so that
+  // direct Sigma converged to m_omega_tol; forms QPQ at the required points
+  void adapt_omega_grid();
   std::vector<std::vector<ComplexGMatrix>>
   form_Greens_kapw(int max_kappa_index, GrMethod method, double omre,
                    const Grid &wgrid) const;
@@ -161,7 +183,7 @@ private:
   sumkl_GQPGQ(const ComplexGMatrix &gA, const ComplexGMatrix &gxBm,
               const ComplexGMatrix &gxBp, const ComplexGMatrix &pa, int kv,
               int kA, int kB, int ka,
-              const std::vector<ComplexGMatrix> *const = nullptr) const;
+              const std::vector<const ComplexGMatrix *> *const = nullptr) const;
 
   [[nodiscard]] GMatrix sumkl_gqgqg(const ComplexGMatrix &gA,
                                     const ComplexGMatrix &gB,
@@ -170,22 +192,20 @@ private:
 
   double Lkl_abcd(int k, int l, int ka, int kb, int kc, int kd) const;
 
-  // result += Real{ sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ] }
-  void tensor_5_product(GMatrix *result, const ComplexDouble &factor,
-                        const ComplexGMatrix &a, const ComplexGMatrix &b,
-                        const ComplexGMatrix &c, const ComplexGMatrix &d,
-                        const ComplexGMatrix &e) const;
-
   // Better solution than this!
   GMatrix Exchange_Goldstone(const int kappa, const double en) const;
 
 private:
   const bool m_screen_Coulomb;
   const bool m_holeParticle;
+  // Store intermediate (QPQ, G) matrices in single precision
+  const bool m_single_precision;
 
   const double m_omre;
   const double m_w0;
   const double m_w_ratio;
+  // Tolerance for adaptive Im(w) grid (0 means use full grid)
+  const double m_omega_tol;
 
   const GrMethod m_Green_method;
   const GrMethod m_Pol_method;
@@ -204,8 +224,11 @@ private:
   std::unique_ptr<Grid> m_wgridD = nullptr;
   // only use every nth point on Im(w) grid for exchange
   std::size_t m_wX_stride{1}; // XXX input?
+  // only use every nth point on Im(w) grid for direct, for each k
+  std::vector<std::size_t> m_wstride_k{};
 
-  std::vector<std::vector<ComplexGMatrix>> m_qpq_wk{};
+  // Stored in single precision if m_single_precision
+  std::vector<std::vector<PackedComplexGMatrix>> m_qpq_wk{};
 
   int m_k_cut = 10; // XXX Make input?
 
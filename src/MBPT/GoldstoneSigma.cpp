@@ -8,9 +8,10 @@
 #include "MBPT/GreenMatrix.hpp"
 #include "Maths/Grid.hpp"
 #include "Maths/LinAlg_MatrixVector.hpp"
-#include "Physics/PhysConst_constants.hpp"
 #include <algorithm>
 #include <numeric>
+#include <string>
+#include <vector>
 
 namespace MBPT {
 
@@ -48,60 +49,31 @@ GoldstoneSigma::GoldstoneSigma(const HF::HartreeFock *const in_hf,
 } // namespace MBPT
 
 //******************************************************************************
-void GoldstoneSigma::formSigma(int kappa, double en, int n) {
+std::pair<GMatrix, GMatrix>
+GoldstoneSigma::calculate_Sigma(int kappa, double en, int n) const {
   // Calc dir + exchange
-  // Print D, X, (D+X) energy shift
-  // Add (D+X) to m_Sigma, and (n,k) to lookup_list
-  // most of this is the same between each...?
-
-  // already exists:
-  const auto index = getSigmaIndex(n, kappa);
-  if (index < m_Sigma_kappa.size()) {
-    const auto [n2, k2, en2] = m_nk[index];
-    // already have this (exact) potential?
-    if (n == n2)
-      return;
-  }
-
-  m_nk.emplace_back(n, kappa, en);
-  auto &Sigma = m_Sigma_kappa.emplace_back(m_subgrid_points, m_include_G);
-
-  // if v.kappa > basis, then Ck angular factor won't exist!
-  if (Angular::twoj_k(kappa) > m_yeh.Ck().max_tj()) {
-    std::cout << "Warning: angular not good\n";
-    return;
-  }
-
-  printf("k=%2i at en=%8.5f.. ", kappa, en);
-  std::cout << std::flush;
-  // this->fill_Sigma_k(&Sigma, kappa, en);
-
-  // auto Gmat_D = Sigma; // copy
-  auto Gmat_X = Sigma; // copy
-  Sigma2(&Sigma, &Gmat_X, kappa, en);
-
-  // find lowest excited state, output <v|S|v> energy shift:
-  const auto find_kappa = [kappa, n](const auto &a) {
-    return a.k == kappa && (a.n == n || n == 0);
-  };
-  const auto vk = std::find_if(cbegin(m_excited), cend(m_excited), find_kappa);
-  if (vk != cend(m_excited)) {
-    auto deD = *vk * act_G_Fv(Sigma, *vk);
-    auto deX = *vk * act_G_Fv(Gmat_X, *vk);
-    // nb: just approximate (uses splines)
-    printf("de= %7.1f + %5.1f = ", deD * PhysConst::Hartree_invcm,
-           deX * PhysConst::Hartree_invcm);
-    printf("%7.1f", (deD + deX) * PhysConst::Hartree_invcm);
-  }
-
-  Sigma += Gmat_X;
-
-  std::cout << "\n";
+  // Read from checkpoint files if available; else calculated + written
+  const auto id = std::to_string(n) + "_" + std::to_string(kappa);
+  auto key = std::vector{double(n), double(kappa), en};
+  key.insert(key.end(), cbegin(m_fk), cend(m_fk));
+
+  GMatrix Gmat_D(m_subgrid_points, m_include_G);
+  auto Gmat_X = Gmat_D; // copy
+  if (read_checkpoint("direct_" + id, key, &Gmat_D) &&
+      read_checkpoint("exchange_" + id, key, &Gmat_X))
+    return {std::move(Gmat_D), std::move(Gmat_X)};
+
+  Gmat_D.zero();
+  Gmat_X.zero();
+  Sigma2(&Gmat_D, &Gmat_X, kappa, en);
+  write_checkpoint("direct_" + id, key, Gmat_D);
+  write_checkpoint("exchange_" + id, key, Gmat_X);
+  return {std::move(Gmat_D), std::move(Gmat_X)};
 }
 
 //******************************************************************************
 void GoldstoneSigma::Sigma2(GMatrix *Gmat_D, GMatrix *Gmat_X, int kappa,
-                            double en) {
+                            double en) const {
   [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
 
   // Four second-order diagrams:
@@ -1,6 +1,7 @@
 #pragma once
 #include "CorrelationPotential.hpp"
 #include <string>
+#include <utility>
 #include <vector>
 namespace HF {
 class HartreeFock;
@@ -45,11 +46,12 @@ public:
   GoldstoneSigma(const GoldstoneSigma &) = delete;
   ~GoldstoneSigma() = default;
 
-  void formSigma(int kappa, double en, int n = 0) override final;
-
 protected:
+  std::pair<GMatrix, GMatrix> calculate_Sigma(int kappa, double en,
+                                              int n) const override final;
+
   // make static!? Or move to base class ? BASE!
-  void Sigma2(GMatrix *Gmat_D, GMatrix *Gmat_X, int kappa, double en);
+  void Sigma2(GMatrix *Gmat_D, GMatrix *Gmat_X, int kappa, double en) const;
 };
 
 } // namespace MBPT
@@ -1,7 +1,15 @@
 #pragma once
+#include "IO/FRW_fileReadWrite.hpp"
 #include "Maths/LinAlg_MatrixVector.hpp"
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <fstream>
 #include <iostream>
+#include <optional>
 #include <type_traits>
+#include <utility>
+#include <vector>
 namespace MBPT {
 
 //******************************************************************************
@@ -299,4 +307,186 @@ using GMatrix = GreenMatrix<LinAlg::SqMatrix>;
 using ComplexGMatrix = GreenMatrix<LinAlg::ComplexSqMatrix>;
 using ComplexDouble = LinAlg::ComplexDouble;
 
+//******************************************************************************
+//! Storage for a complex GreenMatrix, in single or double precision
+/*! @details For storing (many) intermediate matrices, e.g., one per omega.
+Single precision halves the memory (and memory bandwidth); in double
+precision, the ComplexGMatrix itself is stored (no conversion, and no copy
+needed to use it: see matrix()). No arithmetic is defined: use unpack() to get
+back a ComplexGMatrix, or add_Re_product(), which accumulates in double.
+*/
+class PackedComplexGMatrix {
+public:
+  PackedComplexGMatrix() = default;
+
+  PackedComplexGMatrix(ComplexGMatrix g, bool single_precision)
+      : m_include_G(g.m_include_G),
+        m_size(g.size),
+        m_single(single_precision) {
+    if (!m_single) {
+      m_g.emplace(std::move(g));
+      return;
+    }
+    m_f.reserve(num_blocks() * m_size * m_size);
+    for (const auto *blk : blocks(g)) {
+      for (auto i = 0ul; i < m_size; ++i) {
+        for (auto j = 0ul; j < m_size; ++j) {
+          const auto [re, im] = LinAlg::ComplexDouble((*blk)[i][j]).unpack();
+          m_f.emplace_back(float(re), float(im));
+        }
+      }
+    }
+  }
+
+  //! Returns (double precision) copy as ComplexGMatrix
+  [[nodiscard]] ComplexGMatrix unpack() const {
+    if (m_g)
+      return *m_g;
+    ComplexGMatrix g(m_size, m_include_G);
+    const auto blks = blocks(g);
+    for (auto b = 0ul; b < blks.size(); ++b) {
+      for (auto i = 0ul; i < m_size; ++i) {
+        for (auto j = 0ul; j < m_size; ++j) {
+          const auto z = get(b, i, j);
+          (*blks[b])[i][j] = LinAlg::ComplexDouble(z.real(), z.imag()).val;
+        }
+      }
+    }
+    return g;
+  }
+
+  //! Stored matrix, if stored in double precision (else nullptr)
+  const ComplexGMatrix *matrix() const { return m_g ? &*m_g : nullptr; }
+
+  bool single_precision() const { return m_single; }
+  //! True if default-constructed (nothing stored)
+  bool empty() const { return m_f.empty() && !m_g; }
+
+  //! Reads/writes from/to binary file
+  void rw(std::fstream &iofs, IO::FRW::RoW rw) {
+    // nb: double-precision matrix is written element-wise (as for float)
+    std::vector<std::complex<double>> t_d;
+    if (rw == IO::FRW::write && m_g) {
+      t_d.reserve(num_blocks() * m_size * m_size);
+      for (auto b = 0ul; b < num_blocks(); ++b)
+        for (auto i = 0ul; i < m_size; ++i)
+          for (auto j = 0ul; j < m_size; ++j)
+            t_d.push_back(get(b, i, j));
+    }
+    IO::FRW::rw_binary(iofs, rw, m_include_G, m_size, m_single, m_f, t_d);
+    if (rw == IO::FRW::read) {
+      m_g.reset();
+      if (!t_d.empty()) {
+        m_g.emplace(m_size, m_include_G);
+        auto k = 0ul;
+        for (auto *blk : blocks(*m_g))
+          for (auto i = 0ul; i < m_size; ++i)
+            for (auto j = 0ul; j < m_size; ++j, ++k)
+              (*blk)[i][j] =
+                  LinAlg::ComplexDouble(t_d[k].real(), t_d[k].imag()).val;
+      }
+    }
+  }
+
+  //! Memory used for storage (bytes)
+  std::size_t bytes() const {
+    return m_g ? num_blocks() * m_size * m_size * sizeof(std::complex<double>)
+               : m_f.size() * sizeof(m_f[0]);
+  }
+
+  //! Largest |stored - g| over elements, relative to largest |g|
+  double rel_error(const ComplexGMatrix &g) const {
+    double max_diff = 0.0, max_g = 0.0;
+    const auto blks = blocks(g);
+    for (auto b = 0ul; b < blks.size(); ++b) {
+      for (auto i = 0ul; i < m_size; ++i) {
+        for (auto j = 0ul; j < m_size; ++j) {
+          const auto [re, im] =
+              LinAlg::ComplexDouble((*blks[b])[i][j]).unpack();
+          const auto gij = std::complex<double>{re, im};
+          max_diff = std::max(max_diff, std::abs(get(b, i, j) - gij));
+          max_g = std::max(max_g, std::abs(gij));
+        }
+      }
+    }
+    return max_g == 0.0 ? 0.0 : max_diff / max_g;
+  }
+
+  //! result_ij += Re[x * a_ij * b_ij] (element-wise), accumulated in double
+  friend void add_Re_product(GMatrix *result, const LinAlg::ComplexDouble &x,
+                             const PackedComplexGMatrix &a,
+                             const PackedComplexGMatrix &b) {
+    assert(a.m_size == b.m_size && a.m_include_G == b.m_include_G);
+    const auto n = result->size;
+    const auto cx = std::complex<double>{x.cre(), x.cim()};
+    const auto blks =
+        a.m_include_G
+            ? std::vector<LinAlg::SqMatrix *>{&result->ff, &result->fg,
+                                              &result->gf, &result->gg}
+            : std::vector<LinAlg::SqMatrix *>{&result->ff};
+    for (auto ib = 0ul; ib < blks.size(); ++ib) {
+      for (auto i = 0ul; i < n; ++i) {
+        auto *row = (*blks[ib])[i];
+        a.with_row(ib, i, [&](const auto *ra) {
+          b.with_row(ib, i, [&](const auto *rb) {
+            for (auto j = 0ul; j < n; ++j) {
+              row[j] += std::real(cx * to_complex(ra[j]) * to_complex(rb[j]));
+            }
+          });
+        });
+      }
+    }
+  }
+
+private:
+  bool m_include_G{false};
+  std::size_t m_size{0};
+  bool m_single{false};
+  // Single: elements of ff, fg, gf, gg (in that order, row-major)
+  std::vector<std::complex<float>> m_f{};
+  // Double: the matrix itself
+  std::optional<ComplexGMatrix> m_g{};
+
+  std::size_t num_blocks() const { return m_include_G ? 4 : 1; }
+
+  // Block b (ff, fg, gf, gg) of stored double-precision matrix
+  const LinAlg::ComplexSqMatrix &block(std::size_t b) const {
+    return b == 0 ? m_g->ff : b == 1 ? m_g->fg : b == 2 ? m_g->gf : m_g->gg;
+  }
+
+  // Calls f(row), with row a pointer to row i of block b: either
+  // std::complex<float> (single) or gsl_complex (double)
+  template <typename F>
+  void with_row(std::size_t b, std::size_t i, const F &f) const {
+    if (m_g) {
+      const gsl_complex *row = block(b)[i];
+      f(row);
+    } else {
+      f(m_f.data() + (b * m_size + i) * m_size);
+    }
+  }
+
+  static std::complex<double> to_complex(const std::complex<float> &z) {
+    return std::complex<double>(z);
+  }
+  static std::complex<double> to_complex(const gsl_complex &z) {
+    return {GSL_REAL(z), GSL_IMAG(z)};
+  }
+
+  // Element (i,j) of block b (ff, fg, gf, gg)
+  std::complex<double> get(std::size_t b, std::size_t i, std::size_t j) const {
+    std::complex<double> z;
+    with_row(b, i, [&](const auto *row) { z = to_complex(row[j]); });
+    return z;
+  }
+
+  // Pointers to each of ff, fg, gf, gg (or just ff) blocks of g
+  template <typename G>
+  std::vector<decltype(&std::declval<G &>().ff)> blocks(G &g) const {
+    if (m_include_G)
+      return {&g.ff, &g.fg, &g.gf, &g.gg};
+    return {&g.ff};
+  }
+};
+
 } // namespace MBPT
@@ -3,6 +3,8 @@
 #include "DiracOperator/TensorOperator.hpp"
 #include "ExternalField/TDHF.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
+#include <algorithm>
+#include <cstdio>
 #include <numeric>
 #include <vector>
 
@@ -35,6 +37,27 @@ StructureRad::StructureRad(const std::vector<DiracSpinor> &basis,
       mExcited.push_back(Fn);
     }
   }
+
+  // Tabulate Q^k integrals with (at least) two core states. These cover most
+  // of those used in the diagrams, but only if the legs {w,v} are also basis
+  // states. Others are calculated as required.
+  std::vector<DiracSpinor> orbs = mCore;
+  orbs.insert(end(orbs), cbegin(mExcited), cend(mExcited));
+  const auto num_core = [en_core](const auto &... Fi) {
+    return (... + int(Fi.en < en_core));
+  };
+  mQ.fill(orbs, mY, -1,
+          [&](const auto &Fa, const auto &Fb, const auto &Fc,
+              const auto &Fd) { return num_core(Fa, Fb, Fc, Fd) >= 2; });
+  printf("StructureRad: tabulated %lu Q^k integrals: %.1f MB\n", mQ.size(),
+         double(mQ.bytes()) / 1.0e6);
+}
+
+//******************************************************************************
+double StructureRad::Qk(int k, const DiracSpinor &a, const DiracSpinor &b,
+                        const DiracSpinor &c, const DiracSpinor &d) const {
+  const auto q = mQ.Q_opt(k, a, b, c, d);
+  return q ? *q : mY.Qk(k, a, b, c, d);
 }
 
 //******************************************************************************
@@ -177,6 +200,180 @@ StructureRad::norm(const DiracOperator::TensorOperator *const h,
   return {-0.5 * t_wv * (nv + nw), -0.5 * tdv_wv * (nv + nw)};
 }
 
+//******************************************************************************
+std::vector<StructureRad::SRN> StructureRad::srn(
+    const DiracOperator::TensorOperator *const h,
+    const std::vector<std::pair<const DiracSpinor *, const DiracSpinor *>> &wv,
+    double omega, const ExternalField::TDHF *const dV) const {
+
+  const auto k = h->rank();
+  const auto Np = wv.size();
+  const auto Nc = mCore.size();
+  const auto Ne = mExcited.size();
+
+  // {t, t+dV}: matrix elements between core/excited states don't depend on
+  // {w,v}, so calculate them just once
+  using td = std::pair<double, double>;
+  const auto t_tdv = [h, dV](const auto &a, const auto &b) -> td {
+    if (h->isZero(a.k, b.k))
+      return {0.0, 0.0};
+    const auto t = h->reducedME(a, b);
+    return {t, dV ? t + dV->dV(a, b) : 0.0};
+  };
+  std::vector<td> t_ar(Nc * Ne), t_ra(Nc * Ne), t_ba(Nc * Nc), t_mr(Ne * Ne);
+#pragma omp parallel for
+  for (auto ia = 0ul; ia < Nc; ++ia) {
+    const auto &a = mCore[ia];
+    for (auto ir = 0ul; ir < Ne; ++ir) {
+      t_ar[ia * Ne + ir] = t_tdv(a, mExcited[ir]);
+      t_ra[ia * Ne + ir] = t_tdv(mExcited[ir], a);
+    }
+    for (auto ib = 0ul; ib < Nc; ++ib) {
+      t_ba[ib * Nc + ia] = t_tdv(mCore[ib], a);
+    }
+  }
+#pragma omp parallel for
+  for (auto im = 0ul; im < Ne; ++im) {
+    for (auto ir = 0ul; ir < Ne; ++ir) {
+      t_mr[im * Ne + ir] = t_tdv(mExcited[im], mExcited[ir]);
+    }
+  }
+
+  // "Top" + "Bottom": parallelise over (pairs)x(excited)
+  std::vector<td> tb(Np * Ne);
+#pragma omp parallel for schedule(dynamic)
+  for (auto i = 0ul; i < Np * Ne; ++i) {
+    const auto &w = *wv[i / Ne].first;
+    const auto &v = *wv[i / Ne].second;
+    const auto ir = i % Ne;
+    const auto &r = mExcited[ir];
+    if (h->isZero(w.k, v.k))
+      continue;
+    auto &[sr, sr_dv] = tb[i];
+    for (auto ia = 0ul; ia < Nc; ++ia) {
+      const auto &a = mCore[ia];
+      if (h->isZero(a.k, r.k))
+        continue;
+
+      const auto inv_era_pw = 1.0 / (r.en - a.en + omega);
+      const auto inv_era_mw = 1.0 / (r.en - a.en - omega);
+
+      const auto T_wrva = t1234(k, w, r, v, a);
+      const auto B_wavr = v == w ? T_wrva : b1234(k, w, a, v, r);
+
+      const auto [t_ar_, tdv_ar] = t_ar[ia * Ne + ir];
+      const auto [t_ra_, tdv_ra] = t_ra[ia * Ne + ir];
+      sr += (t_ar_ * T_wrva * inv_era_pw) + (t_ra_ * B_wavr * inv_era_mw);
+      if (dV)
+        sr_dv +=
+            (tdv_ar * T_wrva * inv_era_pw) + (tdv_ra * B_wavr * inv_era_mw);
+    }
+  }
+
+  // "Centre": parallelise over (pairs)x(core) and (pairs)x(excited)
+  std::vector<td> c_core(Np * Nc), c_exc(Np * Ne);
+#pragma omp parallel for schedule(dynamic)
+  for (auto i = 0ul; i < Np * Nc; ++i) {
+    const auto &w = *wv[i / Nc].first;
+    const auto &v = *wv[i / Nc].second;
+    const auto ia = i % Nc;
+    const auto &a = mCore[ia];
+    if (h->isZero(w.k, v.k))
+      continue;
+    auto &[src, src_dv] = c_core[i];
+    for (auto ib = 0ul; ib < Nc; ++ib) {
+      const auto &b = mCore[ib];
+      if (h->isZero(b.k, a.k))
+        continue;
+      const auto C_wavb = c1(k, w, a, v, b) + c2(k, w, a, v, b);
+      const auto [t_ba_, tdv_ba] = t_ba[ib * Nc + ia];
+      // nb: -ve
+      src -= t_ba_ * C_wavb;
+      if (dV)
+        src_dv -= tdv_ba * C_wavb;
+    }
+  }
+#pragma omp parallel for schedule(dynamic)
+  for (auto i = 0ul; i < Np * Ne; ++i) {
+    const auto &w = *wv[i / Ne].first;
+    const auto &v = *wv[i / Ne].second;
+    const auto im = i % Ne;
+    const auto &m = mExcited[im];
+    if (h->isZero(w.k, v.k))
+      continue;
+    auto &[src, src_dv] = c_exc[i];
+    for (auto ir = 0ul; ir < Ne; ++ir) {
+      const auto &r = mExcited[ir];
+      if (h->isZero(m.k, r.k))
+        continue;
+      const auto C_wrvm = d2(k, w, r, v, m) + d1(k, w, r, v, m);
+      const auto [t_mr_, tdv_mr] = t_mr[im * Ne + ir];
+      // nb: -ve
+      src -= t_mr_ * C_wrvm;
+      if (dV)
+        src_dv -= tdv_mr * C_wrvm;
+    }
+  }
+
+  // Normalisation: n1(v)+n2(v) depends only on single state; calculate once
+  // for each. Parallelise over (states)x(excited)
+  std::vector<const DiracSpinor *> legs;
+  for (const auto &[w, v] : wv) {
+    for (const auto Fv : {w, v}) {
+      if (std::find(cbegin(legs), cend(legs), Fv) == cend(legs))
+        legs.push_back(Fv);
+    }
+  }
+  std::vector<double> n12(legs.size() * Ne);
+#pragma omp parallel for schedule(dynamic)
+  for (auto i = 0ul; i < legs.size() * Ne; ++i) {
+    const auto &v = *legs[i / Ne];
+    const auto &n = mExcited[i % Ne];
+    for (const auto &a : mCore) {
+      for (const auto &b : mCore) {
+        n12[i] += dSigma_dE(v, n, a, b);
+      }
+      for (const auto &m : mExcited) {
+        n12[i] += dSigma_dE(v, a, m, n);
+      }
+    }
+  }
+  const auto norm_v = [&](const DiracSpinor *Fv) {
+    const auto il = std::size_t(
+        std::find(cbegin(legs), cend(legs), Fv) - cbegin(legs));
+    return std::accumulate(cbegin(n12) + long(il * Ne),
+                           cbegin(n12) + long((il + 1) * Ne), 0.0);
+  };
+
+  // Collect results for each pair
+  const auto sum = [](auto first, auto last) {
+    return std::accumulate(first, last, td{0.0, 0.0}, [](td x, td y) {
+      return td{x.first + y.first, x.second + y.second};
+    });
+  };
+  std::vector<SRN> result(Np);
+  for (auto ip = 0ul; ip < Np; ++ip) {
+    const auto &[w, v] = wv[ip];
+    if (h->isZero(w->k, v->k))
+      continue;
+    auto &[rtb, rc, rn] = result[ip];
+    const auto ie = long(ip * Ne);
+    const auto ic = long(ip * Nc);
+    rtb = sum(cbegin(tb) + ie, cbegin(tb) + ie + long(Ne));
+    const auto cc = sum(cbegin(c_core) + ic, cbegin(c_core) + ic + long(Nc));
+    const auto ce = sum(cbegin(c_exc) + ie, cbegin(c_exc) + ie + long(Ne));
+    rc = {cc.first + ce.first, cc.second + ce.second};
+
+    const auto t_wv = h->reducedME(*w, *v);
+    const auto tdv_wv = dV ? t_wv + dV->dV(*w, *v) : 0.0;
+    const auto nv = norm_v(v);
+    const auto nw = w == v ? nv : norm_v(w);
+    rn = {-0.5 * t_wv * (nv + nw), -0.5 * tdv_wv * (nv + nw)};
+  }
+
+  return result;
+}
+
 //******************************************************************************
 //******************************************************************************
 double StructureRad::t1234(int k, const DiracSpinor &w, const DiracSpinor &r,
@@ -211,7 +408,7 @@ double StructureRad::t1(const int k, const DiracSpinor &w, const DiracSpinor &r,
         continue;
       for (int l = minL; l <= maxL; l += 2) {
 
-        const auto ql = mY.Qk(l, v, a, b, c);
+        const auto ql = Qk(l, v, a, b, c);
         if (Angular::zeroQ(ql))
           continue;
 
@@ -337,7 +534,7 @@ double StructureRad::t4(const int k, const DiracSpinor &w, const DiracSpinor &r,
         continue;
       for (int u = minU; u <= maxU; u += 2) {
 
-        const auto qu = mY.Qk(u, w, r, n, m);
+        const auto qu = Qk(u, w, r, n, m);
         if (Angular::zeroQ(qu))
           continue;
 
@@ -424,7 +621,7 @@ double StructureRad::c2(const int k, const DiracSpinor &w, const DiracSpinor &a,
         continue;
       for (int u = minU; u <= maxU; u += 2) {
 
-        const auto qu = mY.Qk(u, v, m, n, c);
+        const auto qu = Qk(u, v, m, n, c);
         if (Angular::zeroQ(qu))
           continue;
 
@@ -512,7 +709,7 @@ double StructureRad::d2(const int k, const DiracSpinor &w, const DiracSpinor &r,
         continue;
       for (int u = minU; u <= maxU; u += 2) {
 
-        const auto qu = mY.Qk(u, v, b, a, m);
+        const auto qu = Qk(u, v, b, a, m);
         if (Angular::zeroQ(qu))
           continue;
 
@@ -550,7 +747,7 @@ double StructureRad::dSigma_dE(const DiracSpinor &v, const DiracSpinor &i,
 
     const auto tup1 = (2 * u + 1);
 
-    const auto q = mY.Qk(u, v, i, j, k);
+    const auto q = Qk(u, v, i, j, k);
     if (Angular::zeroQ(q))
       continue;
 
@@ -1,7 +1,9 @@
 #pragma once
+#include "Coulomb/QkTable.hpp"
 #include "Coulomb/YkTable.hpp"
 #include "IO/FRW_fileReadWrite.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
+#include <utility>
 #include <vector>
 class Wavefunction;
 class DiracSpinor;
@@ -32,6 +34,9 @@ calculated using the spline states)
  - For using spline states as legs: This means you must typically ensure basis
 is large enough to make relevant valence states "physical"
 
+ - Q^k integrals with at least two core states are tabulated on construction
+(Coulomb::QkTable); these are used when the legs are themselves basis states
+
  - The user should check if the zeroth order <w|t|v> matches closely between
 valence/spline states. If not, basis/cavity is too small and SR+N probably
 meaningless
@@ -63,6 +68,8 @@ private:
   // Store local copy of basis (seems to make faster)
   std::vector<DiracSpinor> mBasis;
   Coulomb::YkTable mY;
+  // Table of (some) Q^k integrals; see constructor
+  Coulomb::QkTable mQ{};
   // nb: it seems conter-intuative, but this copy makes it FASTER!
   std::vector<DiracSpinor> mCore{}, mExcited{};
 
@@ -88,7 +95,30 @@ public:
        const DiracSpinor &v,
        const ExternalField::TDHF *const dV = nullptr) const;
 
+  //! Structure radiation + normalisation, {x, x+dV}, for a single {w,v}
+  struct SRN {
+    std::pair<double, double> tb{0.0, 0.0}, c{0.0, 0.0}, n{0.0, 0.0};
+  };
+
+  //! Calculates srTB(), srC() and norm() for a list of {w,v} pairs at once.
+  /*! @details Returns vector (same order as wv) of {TB, C, N}. Much faster
+  than calling each for every pair: matrix elements of h (and dV) between
+  core/excited states are calculated once and shared across all pairs;
+  normalisation calculated once per state; and the parallelisation is over
+  (pairs)x(core/excited) states. All pairs use same omega.
+  */
+  std::vector<SRN>
+  srn(const DiracOperator::TensorOperator *const h,
+      const std::vector<std::pair<const DiracSpinor *, const DiracSpinor *>>
+          &wv,
+      double omega = 0.0,
+      const ExternalField::TDHF *const dV = nullptr) const;
+
 private:
+  // Q^k_abcd: uses table if all states are included, otherwise calculates
+  double Qk(int k, const DiracSpinor &a, const DiracSpinor &b,
+            const DiracSpinor &c, const DiracSpinor &d) const;
+
   // "Top" diagrams
   double t1234(int k, const DiracSpinor &w, const DiracSpinor &r,
                const DiracSpinor &v, const DiracSpinor &c) const;
@@ -6,6 +6,7 @@
 #include "Wavefunction/Wavefunction.hpp"
 #include "qip/Check.hpp"
 #include <algorithm>
+#include <array>
 #include <string>
 
 namespace UnitTest {
@@ -47,6 +48,9 @@ bool StructureRad(std::ostream &obuff) {
     double worst_ns = 0.0;
     std::string at_sr = "";
     std::string at_ns = "";
+    // For comparing to batched calculation:
+    std::vector<std::pair<const DiracSpinor *, const DiracSpinor *>> wv;
+    std::vector<std::array<double, 3>> tbcn;
     for (const auto &[w_str, v_str, sr_exp, n_exp] : expected) {
 
       // find the right basis states for SR/N "legs"
@@ -63,6 +67,8 @@ bool StructureRad(std::ostream &obuff) {
       const auto [tb, dv1] = sr.srTB(&h, *ws, *vs, 0.0);
       const auto [c, dv2] = sr.srC(&h, *ws, *vs);
       const auto [n, dv3] = sr.norm(&h, *ws, *vs);
+      wv.emplace_back(&*ws, &*vs);
+      tbcn.push_back({tb, c, n});
 
       // output table as we go:
       std::cout << "<" << w_str << "||" << v_str << ">: ";
@@ -87,6 +93,19 @@ bool StructureRad(std::ostream &obuff) {
                              0.1);
     pass &= qip::check_value(&obuff, "NormStates(E1,Na) " + at_ns, worst_ns,
                              0.0, 0.05);
+
+    // Batched calculation should give identical results
+    const auto batch = sr.srn(&h, wv);
+    double worst_batch = 0.0;
+    for (std::size_t i = 0; i < wv.size(); ++i) {
+      const auto &[tb, c, n] = batch[i];
+      const auto &[tb0, c0, n0] = tbcn[i];
+      worst_batch = std::max({worst_batch, std::abs(tb.first / tb0 - 1.0),
+                              std::abs(c.first / c0 - 1.0),
+                              std::abs(n.first / n0 - 1.0)});
+    }
+    pass &= qip::check_value(&obuff, "StructRad batched (Na)", worst_batch,
+                             0.0, 1.0e-12);
   }
 
   //****************************************************************************
@@ -0,0 +1,134 @@
+#include "MBPT/TensorProduct.hpp"
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_complex.h>
+#include <vector>
+
+namespace MBPT {
+
+//******************************************************************************
+void tensor_5_product(GMatrix *result, const ComplexDouble &factor,
+                      const ComplexGMatrix &a, const ComplexGMatrix &b,
+                      const ComplexGMatrix &c, const ComplexGMatrix &d,
+                      const ComplexGMatrix &e) {
+  // Adds real part of below to result
+  // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
+  // = sum_i e_i2 * Y_i2, Y = X.c, X_ij = factor * d_1i * a_1j * b_ij
+  const auto n = result->size;
+  if (n == 0)
+    return;
+
+  // Real/imag planes of c. c is often real: then, Im(c) product not needed
+  std::vector<double> cr(n * n), ci(n * n);
+  bool c_complex = false;
+  for (auto i = 0ul; i < n; ++i) {
+    const auto ci_row = c.ff[i];
+    for (auto j = 0ul; j < n; ++j) {
+      cr[i * n + j] = GSL_REAL(ci_row[j]);
+      ci[i * n + j] = GSL_IMAG(ci_row[j]);
+      c_complex = c_complex || ci[i * n + j] != 0.0;
+    }
+  }
+
+  // X = [Xr; Xi] is (2n x n); so [Xr; Xi].cr = [Xr.cr; Xi.cr] is one product
+  std::vector<double> x(2 * n * n), p(2 * n * n);
+  std::vector<double> q(c_complex ? 2 * n * n : 0);
+  std::vector<double> ar(n), ai(n);
+  auto X = gsl_matrix_view_array(x.data(), 2 * n, n);
+  auto P = gsl_matrix_view_array(p.data(), 2 * n, n);
+  auto Cr = gsl_matrix_view_array(cr.data(), n, n);
+  auto Ci = gsl_matrix_view_array(ci.data(), n, n);
+
+  const auto [fr, fi] = factor.unpack();
+
+  for (auto r1 = 0ul; r1 < n; ++r1) {
+    const auto a1 = a.ff[r1];
+    const auto d1 = d.ff[r1];
+    for (auto j = 0ul; j < n; ++j) {
+      ar[j] = GSL_REAL(a1[j]);
+      ai[j] = GSL_IMAG(a1[j]);
+    }
+
+    for (auto i = 0ul; i < n; ++i) {
+      // t = factor * d_1i
+      const auto dr = GSL_REAL(d1[i]);
+      const auto di = GSL_IMAG(d1[i]);
+      const auto tr = fr * dr - fi * di;
+      const auto ti = fr * di + fi * dr;
+      const auto bi = b.ff[i];
+      auto *xr = x.data() + i * n;
+      auto *xi = x.data() + (n + i) * n;
+      for (auto j = 0ul; j < n; ++j) {
+        // u = a_1j * b_ij ; x = t * u
+        const auto ur = ar[j] * GSL_REAL(bi[j]) - ai[j] * GSL_IMAG(bi[j]);
+        const auto ui = ar[j] * GSL_IMAG(bi[j]) + ai[j] * GSL_REAL(bi[j]);
+        xr[j] = tr * ur - ti * ui;
+        xi[j] = tr * ui + ti * ur;
+      }
+    }
+
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &X.matrix, &Cr.matrix, 0.0,
+                   &P.matrix);
+    if (c_complex) {
+      auto Q = gsl_matrix_view_array(q.data(), 2 * n, n);
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &X.matrix, &Ci.matrix,
+                     0.0, &Q.matrix);
+      // Y = [Xr.cr - Xi.ci] + i[Xi.cr + Xr.ci]
+      for (auto i = 0ul; i < n; ++i) {
+        auto *yr = p.data() + i * n;
+        auto *yi = p.data() + (n + i) * n;
+        const auto *qr = q.data() + i * n;
+        const auto *qi = q.data() + (n + i) * n;
+        for (auto r2 = 0ul; r2 < n; ++r2) {
+          yr[r2] -= qi[r2];
+          yi[r2] += qr[r2];
+        }
+      }
+    }
+
+    // result_12 += Re{sum_i e_i2 * Y_i2}
+    auto *res = result->ff[r1];
+    for (auto i = 0ul; i < n; ++i) {
+      const auto ei = e.ff[i];
+      const auto *yr = p.data() + i * n;
+      const auto *yi = p.data() + (n + i) * n;
+      for (auto r2 = 0ul; r2 < n; ++r2) {
+        res[r2] += GSL_REAL(ei[r2]) * yr[r2] - GSL_IMAG(ei[r2]) * yi[r2];
+      }
+    }
+  } // r1
+}
+
+//******************************************************************************
+void tensor_5_product_ref(GMatrix *result, const ComplexDouble &factor,
+                          const ComplexGMatrix &a, const ComplexGMatrix &b,
+                          const ComplexGMatrix &c, const ComplexGMatrix &d,
+                          const ComplexGMatrix &e) {
+  // Adds real part of below to result
+  // Sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ]
+  const auto size = result->size;
+
+  // The a*c part depends only on j (not i).
+  // Doing this mult early saves factor of 'size' complex multiplications
+  std::vector<ComplexDouble> ac(size); // see below
+
+  for (auto r1 = 0ul; r1 < size; ++r1) {
+    for (auto r2 = 0ul; r2 < size; ++r2) {
+
+      for (auto j = 0ul; j < size; ++j) {
+        ac[j] = ComplexDouble(a.ff[r1][j]) * c.ff[j][r2];
+      }
+      ComplexDouble sum_ij{0.0, 0.0};
+      for (auto i = 0ul; i < size; ++i) {
+        ComplexDouble sum_j{0.0, 0.0};
+        for (auto j = 0ul; j < size; ++j) {
+          sum_j += ac[j] * b.ff[i][j];
+        }
+        sum_ij += sum_j * d.ff[r1][i] * e.ff[i][r2];
+      }
+      result->ff[r1][r2] += (factor * sum_ij).cre();
+
+    } // r2
+  }   // r1
+}
+
+} // namespace MBPT
@@ -0,0 +1,29 @@
+#pragma once
+#include "MBPT/GreenMatrix.hpp"
+
+namespace MBPT {
+
+//! result += Real{ sum_ij [ factor * a1j * bij * cj2 * (d_1i * e_i2) ] }
+/*! @details For each r1, the sum over j is a matrix product:
+  sum_ij [e_i2 * (X.c)_i2],  X_ij = factor * d_1i * a_1j * b_ij.
+The product is done with BLAS (gsl_blas_dgemm) on separate, contiguous, real
+and imaginary planes; this is much faster than explicit loops (and faster still
+if linked to an optimised CBLAS library). Only one real product is needed per r1
+when c is real (e.g., a projection operator |a><a|).
+ - The result is linear in factor and in e: when called for many e with the same
+   a,b,c,d, it is much cheaper to first sum the e's (see
+   FeynmanSigma::sumkl_gqgqg)
+ - Only the ff part of the matrices is used (as before)
+*/
+void tensor_5_product(GMatrix *result, const ComplexDouble &factor,
+                      const ComplexGMatrix &a, const ComplexGMatrix &b,
+                      const ComplexGMatrix &c, const ComplexGMatrix &d,
+                      const ComplexGMatrix &e);
+
+//! As tensor_5_product, but with explicit loops (reference version; slow)
+void tensor_5_product_ref(GMatrix *result, const ComplexDouble &factor,
+                          const ComplexGMatrix &a, const ComplexGMatrix &b,
+                          const ComplexGMatrix &c, const ComplexGMatrix &d,
+                          const ComplexGMatrix &e);
+
+} // namespace MBPT
@@ -0,0 +1,176 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
+//! Piecewise Chebyshev approximation of a smooth function of r (in ln r)
+/*! @details
+Used to tabulate functions that are expensive to evaluate (e.g., those defined
+by integrals), so that they may then be evaluated cheaply on many grid points.
+
+The interval [r0, r1] is split (in ln r) into segments; on each, f is
+approximated by a Chebyshev series of degree N-1 (f evaluated at the N
+Chebyshev nodes). Segments are bisected until the estimated error (size of last
+two Chebyshev coeficients) is below eps, relative to the largest value of |f|
+on that segment (or a small fraction of the global maximum, so that
+exponentially small tails are not needlessly refined).
+
+ - break points (e.g., nuclear radius) are always segment boundaries; use these
+   for points where f is not smooth.
+ - All the nodes for each refinement level are evaluated in parallel; f must be
+   thread-safe.
+ - Only valid for r0 <= r <= r1; outside this, r is treated as nearest end.
+*/
+class ChebyshevTable {
+public:
+  //! Number of Chebyshev nodes (=degree+1) per segment
+  static constexpr std::size_t N = 16;
+
+  ChebyshevTable() = default;
+
+  //! Tabulates f on [r0, r1] (r0>0), to relative accuracy ~eps.
+  /*! @details At most max_segments segments used (max_segments*N evaluations
+  of f); if reached, the achieved accuracy is given by error_estimate().
+  */
+  ChebyshevTable(const std::function<double(double)> &f, double r0, double r1,
+                 double eps = 1.0e-8, const std::vector<double> &breaks = {},
+                 std::size_t max_segments = 512);
+
+  //! Evaluates tabulated function at r
+  double operator()(double r) const;
+
+  //! Largest (relative) error estimate over all segments
+  double error_estimate() const { return m_error; }
+  //! Number of times f was evaluated to form table
+  std::size_t num_evaluations() const { return m_num_evals; }
+  std::size_t num_segments() const { return m_segs.size(); }
+
+private:
+  // segment in u = ln(r): [a,b], with Chebyshev coeficients c
+  struct Segment {
+    double a, b;
+    std::array<double, N> c;
+  };
+  std::vector<Segment> m_segs{};
+  double m_error{0.0};
+  std::size_t m_num_evals{0};
+
+  // Fraction of global max |f|, below which values are considered negligible
+  static constexpr double m_floor = 1.0e-10;
+  // Initial (maximum) width of segments, in ln(r)
+  static constexpr double m_du_max = 2.0;
+
+  static double node(std::size_t k) {
+    return std::cos(M_PI * (double(k) + 0.5) / double(N));
+  }
+};
+
+//******************************************************************************
+//******************************************************************************
+inline ChebyshevTable::ChebyshevTable(const std::function<double(double)> &f,
+                                      double r0, double r1, double eps,
+                                      const std::vector<double> &breaks,
+                                      std::size_t max_segments) {
+
+  // Initial segments: split at each break point, then to have width<du_max
+  std::vector<double> edges{std::log(r0)};
+  for (const auto rb : breaks) {
+    if (rb > r0 && rb < r1)
+      edges.push_back(std::log(rb));
+  }
+  edges.push_back(std::log(r1));
+  std::sort(begin(edges), end(edges));
+
+  std::vector<std::pair<double, double>> todo;
+  for (std::size_t i = 0; i + 1 < edges.size(); ++i) {
+    const auto width = edges[i + 1] - edges[i];
+    const auto n_sub = std::max(1.0, std::ceil(width / m_du_max));
+    const auto du = width / n_sub;
+    for (int j = 0; j < int(n_sub); ++j) {
+      const auto a = edges[i] + j * du;
+      const auto b = j == int(n_sub) - 1 ? edges[i + 1] : a + du;
+      todo.emplace_back(a, b);
+    }
+  }
+
+  double global_max = 0.0;
+  while (!todo.empty()) {
+
+    // Evaluate f at nodes of all new segments (in parallel)
+    std::vector<double> fk(todo.size() * N);
+#pragma omp parallel for
+    for (std::size_t i = 0; i < fk.size(); ++i) {
+      const auto [a, b] = todo[i / N];
+      const auto u = 0.5 * (a + b) + 0.5 * (b - a) * node(i % N);
+      fk[i] = f(std::exp(u));
+    }
+    m_num_evals += fk.size();
+
+    for (const auto fi : fk)
+      global_max = std::max(global_max, std::abs(fi));
+
+    // Don't refine further if max_segments would be exceeded
+    const bool can_refine = m_segs.size() + 2 * todo.size() <= max_segments;
+
+    std::vector<std::pair<double, double>> next;
+    for (std::size_t is = 0; is < todo.size(); ++is) {
+      const auto [a, b] = todo[is];
+      const auto f0 = fk.begin() + long(is * N);
+
+      // Chebyshev coeficients (discrete cosine transform)
+      Segment seg{a, b, {}};
+      double seg_max = 0.0;
+      for (std::size_t j = 0; j < N; ++j) {
+        double cj = 0.0;
+        for (std::size_t k = 0; k < N; ++k) {
+          cj += f0[long(k)] *
+                std::cos(M_PI * double(j) * (double(k) + 0.5) / double(N));
+        }
+        seg.c[j] = 2.0 * cj / double(N);
+        seg_max = std::max(seg_max, std::abs(f0[long(j)]));
+      }
+
+      const auto scale = std::max(seg_max, m_floor * global_max);
+      const auto err = std::abs(seg.c[N - 1]) + std::abs(seg.c[N - 2]);
+      const auto rel_err = scale == 0.0 ? 0.0 : err / scale;
+      if (rel_err > eps && can_refine) {
+        const auto mid = 0.5 * (a + b);
+        next.emplace_back(a, mid);
+        next.emplace_back(mid, b);
+      } else {
+        m_error = std::max(m_error, rel_err);
+        m_segs.push_back(seg);
+      }
+    }
+    todo = std::move(next);
+  }
+
+  std::sort(begin(m_segs), end(m_segs),
+            [](const auto &s1, const auto &s2) { return s1.a < s2.a; });
+}
+
+//******************************************************************************
+inline double ChebyshevTable::operator()(double r) const {
+  if (m_segs.empty())
+    return 0.0;
+  const auto u = std::clamp(std::log(r), m_segs.front().a, m_segs.back().b);
+
+  // Find segment: first with b >= u
+  const auto seg = std::lower_bound(
+      begin(m_segs), std::prev(end(m_segs)), u,
+      [](const auto &s, double value) { return s.b < value; });
+  const auto &[a, b, c] = *seg;
+
+  // Clenshaw recurrence
+  const auto x = (2.0 * u - a - b) / (b - a);
+  double b1 = 0.0, b2 = 0.0;
+  for (std::size_t j = N - 1; j >= 1; --j) {
+    const auto tmp = 2.0 * x * b1 - b2 + c[j];
+    b2 = b1;
+    b1 = tmp;
+  }
+  return x * b1 - b2 + 0.5 * c[0];
+}
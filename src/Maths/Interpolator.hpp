@@ -2,7 +2,10 @@
 #include "IO/SafeProfiler.hpp"
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_spline.h>
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <limits>
 #include <vector>
 
 // https://www.gnu.org/software/gsl/doc/html/interp.html
@@ -52,4 +55,154 @@ inline std::vector<double> interpolate(const std::vector<double> &x_in,
   return y_out;
 }
 
+//******************************************************************************
+//! @brief Re-usable cubic spline interpolation, from fixed points {x_in} onto
+//! fixed points {x_out}
+/*! @details
+For repeated interpolation between the same pair of grids (of many different
+y vectors). Same result (natural cubic spline) as interpolate(), to rounding.
+
+Spline interpolation is linear in y. Everything that depends only on the x
+values is done once, at construction: the bracketing interval of each x_out
+point (and its four weights), and the factorisation of the (tridiagonal)
+equations for the spline second derivatives M. Each interpolation is then just
+a tridiagonal back-substitution for M (O(N_in)), and a four-point stencil for
+each output point (O(N_out)):
+  y(x) = A*y_i + B*y_{i+1} + C*M_i + D*M_{i+1}
+
+  - NOTE: Interpolates, but does NOT extrapolate! Everything outside the
+  region [xmin,xmax]_in will be zero
+  - x_in must be strictly increasing, with at least 2 points
+*/
+class Plan {
+public:
+  Plan(const std::vector<double> &x_in, const std::vector<double> &x_out);
+
+  //! Number of input (x_in) points
+  std::size_t size_in() const { return m_num_in; }
+  //! Number of output (x_out) points
+  std::size_t size_out() const { return m_index.size(); }
+
+  //! Interpolates y_in (given at x_in) onto x_out
+  std::vector<double> operator()(const std::vector<double> &y_in) const {
+    std::vector<double> y_out;
+    apply(y_in, &y_out);
+    return y_out;
+  }
+
+  //! Interpolates each of ys (each given at x_in) onto x_out (in parallel)
+  std::vector<std::vector<double>>
+  operator()(const std::vector<std::vector<double>> &ys) const {
+    std::vector<std::vector<double>> y_outs(ys.size());
+#pragma omp parallel for
+    for (auto i = 0ul; i < ys.size(); ++i) {
+      apply(ys[i], &y_outs[i]);
+    }
+    return y_outs;
+  }
+
+  //! As operator(), but writes into existing y_out (re-sized if required)
+  void apply(const std::vector<double> &y_in,
+             std::vector<double> *y_out) const;
+
+private:
+  static constexpr auto outside = std::numeric_limits<std::size_t>::max();
+  std::size_t m_num_in;
+  // Interval widths, x_{i+1} - x_i
+  std::vector<double> m_h{};
+  // Factorised spline equations (Thomas algorithm): multipliers, and inverse
+  // of (eliminated) diagonal, for the interior points 1..N-2
+  std::vector<double> m_mult{};
+  std::vector<double> m_diag_inv{};
+  // For each output point: lower index of bracketing interval (or 'outside'),
+  // and the weights {A, B, C, D}
+  std::vector<std::size_t> m_index{};
+  std::vector<std::array<double, 4>> m_weights{};
+};
+
+//------------------------------------------------------------------------------
+inline Plan::Plan(const std::vector<double> &x_in,
+                  const std::vector<double> &x_out)
+    : m_num_in(x_in.size()),
+      m_index(x_out.size(), outside),
+      m_weights(x_out.size()) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
+  if (m_num_in < 2) {
+    std::cerr << "FAIL 12 in Interpolator::Plan: need at least 2 points: "
+              << m_num_in << "\n";
+    return;
+  }
+  const auto n = m_num_in;
+
+  m_h.resize(n - 1);
+  for (auto i = 0ul; i < n - 1; ++i) {
+    m_h[i] = x_in[i + 1] - x_in[i];
+  }
+
+  // Natural spline (M_0 = M_{N-1} = 0); for interior i:
+  // h_{i-1} M_{i-1} + 2(h_{i-1}+h_i) M_i + h_i M_{i+1} = 6(dy_i/h_i -
+  // dy_{i-1}/h_{i-1}). Forward elimination only depends on x:
+  m_mult.assign(n, 0.0);
+  m_diag_inv.assign(n, 0.0);
+  for (auto i = 1ul; i + 1 < n; ++i) {
+    auto diag = 2.0 * (m_h[i - 1] + m_h[i]);
+    if (i > 1) {
+      m_mult[i] = m_h[i - 1] * m_diag_inv[i - 1];
+      diag -= m_mult[i] * m_h[i - 1];
+    }
+    m_diag_inv[i] = 1.0 / diag;
+  }
+
+  const auto xmin = x_in.front();
+  const auto xmax = x_in.back();
+  for (auto j = 0ul; j < x_out.size(); ++j) {
+    const auto x = x_out[j];
+    if (x < xmin || x > xmax)
+      continue;
+    // x_i <= x < x_{i+1} (or x = x_{N-1})
+    const auto it = std::upper_bound(cbegin(x_in), cend(x_in), x);
+    const auto i = std::min(std::size_t(it - cbegin(x_in)) - 1, n - 2);
+    const auto h = m_h[i];
+    const auto b = (x - x_in[i]) / h;
+    const auto a = 1.0 - b;
+    m_index[j] = i;
+    m_weights[j] = {a, b, (a * a * a - a) * h * h / 6.0,
+                    (b * b * b - b) * h * h / 6.0};
+  }
+}
+
+//------------------------------------------------------------------------------
+inline void Plan::apply(const std::vector<double> &y_in,
+                        std::vector<double> *y_out) const {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler("Plan::apply");
+
+  y_out->assign(m_index.size(), 0.0);
+  if (y_in.size() != m_num_in || m_num_in < 2) {
+    std::cerr << "FAIL 13 in Interpolator::Plan: y_in has wrong size: "
+              << y_in.size() << " " << m_num_in << "\n";
+    return;
+  }
+  const auto n = m_num_in;
+
+  // Second derivatives: forward substitution, then back substitution
+  std::vector<double> M(n, 0.0);
+  for (auto i = 1ul; i + 1 < n; ++i) {
+    const auto rhs = 6.0 * ((y_in[i + 1] - y_in[i]) / m_h[i] -
+                            (y_in[i] - y_in[i - 1]) / m_h[i - 1]);
+    M[i] = rhs - m_mult[i] * M[i - 1];
+  }
+  for (auto i = n - 2; i >= 1; --i) {
+    M[i] = (M[i] - m_h[i] * M[i + 1]) * m_diag_inv[i];
+  }
+
+  for (auto j = 0ul; j < m_index.size(); ++j) {
+    const auto i = m_index[j];
+    if (i == outside)
+      continue;
+    const auto &[a, b, c, d] = m_weights[j];
+    (*y_out)[j] = a * y_in[i] + b * y_in[i + 1] + c * M[i] + d * M[i + 1];
+  }
+}
+
 } // namespace Interpolator
@@ -0,0 +1,109 @@
+#pragma once
+#include "Maths/Interpolator.hpp"
+#include "qip/Check.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace UnitTest {
+
+//******************************************************************************
+//! Unit tests for Interpolator: re-usable Plan (single, and batched) vs.
+//! interpolate() [GSL cspline]
+bool Interpolator(std::ostream &obuff) {
+  bool pass = true;
+
+  // Largest absolute difference between two vectors (inf. if sizes differ)
+  const auto max_del = [](const std::vector<double> &a,
+                          const std::vector<double> &b) {
+    if (a.size() != b.size())
+      return std::numeric_limits<double>::infinity();
+    double del = 0.0;
+    for (auto i = 0ul; i < a.size(); ++i)
+      del = std::max(del, std::abs(a[i] - b[i]));
+    return del;
+  };
+
+  { // Non-uniform (logarithmic) input grid
+    std::vector<double> x_in;
+    for (int i = 0; i < 150; ++i)
+      x_in.push_back(1.0e-4 * std::exp(0.09 * i));
+    const auto xmin = x_in.front();
+    const auto xmax = x_in.back();
+
+    // Output points: below, across, and above input range; and both end
+    // points exactly
+    std::vector<double> x_out;
+    for (int i = 0; i < 3000; ++i)
+      x_out.push_back(5.0e-5 * std::exp(0.0047 * i));
+    x_out.push_back(xmin);
+    x_out.push_back(xmax);
+
+    // Several functions (to test batched interpolation)
+    std::vector<std::vector<double>> ys(3);
+    for (const auto x : x_in) {
+      ys[0].push_back(std::sin(x) * std::exp(-0.1 * x));
+      ys[1].push_back(x * x * std::exp(-x));
+      ys[2].push_back(1.0 / (1.0 + x));
+    }
+
+    const Interpolator::Plan plan(x_in, x_out);
+    const auto y_plans = plan(ys);
+
+    double del_single = 0.0, del_batch = 0.0, outside = 0.0, ends = 0.0;
+    for (auto k = 0ul; k < ys.size(); ++k) {
+      const auto &y = ys[k];
+      const auto y_gsl = Interpolator::interpolate(x_in, y, x_out);
+      const auto y_plan = plan(y);
+      del_single = std::max(del_single, max_del(y_plan, y_gsl));
+      del_batch = std::max(del_batch, max_del(y_plans[k], y_gsl));
+      if (y_plan.size() != x_out.size())
+        continue;
+      for (auto j = 0ul; j < x_out.size(); ++j) {
+        if (x_out[j] < xmin || x_out[j] > xmax)
+          outside = std::max(outside, std::abs(y_plan[j]));
+      }
+      // x_out.back() = xmax, second last is xmin: exactly the end points
+      ends = std::max({ends, std::abs(y_plan.back() - y.back()),
+                       std::abs(y_plan[x_out.size() - 2] - y.front())});
+    }
+
+    pass &= qip::check_value(&obuff, "Plan vs interpolate", del_single, 0.0,
+                             1.0e-14);
+    pass &= qip::check_value(&obuff, "Plan (batch) vs interpolate", del_batch,
+                             0.0, 1.0e-14);
+    pass &= qip::check_value(&obuff, "Plan outside range", outside, 0.0, 0.0);
+    pass &= qip::check_value(&obuff, "Plan x=xmin, x=xmax", ends, 0.0, 1.0e-15);
+  }
+
+  { // Smallest input sizes
+    // 3 points (smallest for GSL cspline): compare to interpolate()
+    const std::vector<double> x3{0.5, 1.2, 3.0};
+    const std::vector<double> y3{1.0, -2.0, 0.5};
+    // 2 points: natural cubic spline is a straight line (GSL cspline can't
+    // do 2 points, so compare to exact)
+    const std::vector<double> x2{0.5, 3.0};
+    const std::vector<double> y2{1.0, -1.5};
+    const std::vector<double> x_out{0.0, 0.5, 0.7, 1.2, 2.1, 2.9, 3.0, 3.5};
+
+    std::vector<double> y2_exact;
+    for (const auto x : x_out) {
+      const auto in_range = x >= x2.front() && x <= x2.back();
+      y2_exact.push_back(in_range ? y2[0] + (y2[1] - y2[0]) * (x - x2[0]) /
+                                                (x2[1] - x2[0])
+                                  : 0.0);
+    }
+
+    const auto del3 = max_del(Interpolator::Plan(x3, x_out)(y3),
+                              Interpolator::interpolate(x3, y3, x_out));
+    const auto del2 = max_del(Interpolator::Plan(x2, x_out)(y2), y2_exact);
+    pass &= qip::check_value(&obuff, "Plan 3 points", del3, 0.0, 1.0e-14);
+    pass &= qip::check_value(&obuff, "Plan 2 points", del2, 0.0, 1.0e-15);
+  }
+
+  return pass;
+}
+
+} // namespace UnitTest
@@ -23,6 +23,51 @@ constexpr QintCoefs<Nquad> quintcoef;
 constexpr auto cq = quintcoef.cq;
 constexpr auto dq_inv = quintcoef.dq_inv;
 
+//******************************************************************************
+namespace helper {
+
+// Sum_{i=p0}^{pinf-1} v1[i]*v2[i]*...; 'omp simd' allows the sum to be
+// re-ordered, so the loop is vectorised (the compiler can't otherwise)
+template <typename... T>
+inline double product_sum(std::size_t p0, std::size_t pinf, const T *... v) {
+  double res = 0.0;
+#pragma omp simd reduction(+ : res)
+  for (std::size_t i = p0; i < pinf; ++i) {
+    res += (v[i] * ...);
+  }
+  return res;
+}
+
+// Sum_{i=p0}^{pinf-1} (a1[i]*a2[i] + b1[i]*b2[i])*w1[i]*w2[i]*...
+template <typename... T>
+inline double product_pairs_sum(std::size_t p0, std::size_t pinf,
+                                const double *a1, const double *a2,
+                                const double *b1, const double *b2,
+                                const T *... w) {
+  double res = 0.0;
+#pragma omp simd reduction(+ : res)
+  for (std::size_t i = p0; i < pinf; ++i) {
+    res += (a1[i] * a2[i] + b1[i] * b2[i]) * (1.0 * ... * w[i]);
+  }
+  return res;
+}
+
+// Quadrature end-point corrections: term(i) is the integrand at point i
+template <typename F>
+inline double end_corrections(std::size_t beg, std::size_t end,
+                              std::size_t end_mid, const F &term) {
+  double res = 0.0;
+  for (auto i = beg; i < Nquad; ++i) {
+    res += cq[i] * term(i);
+  }
+  for (auto i = end_mid; i < end; ++i) {
+    res += cq[end_mid + Nquad - i - 1] * term(i);
+  }
+  return res;
+}
+
+} // namespace helper
+
 //******************************************************************************
 template <typename C, typename... Args>
 inline double integrate(const double dt, std::size_t beg, std::size_t end,
@@ -45,14 +90,46 @@ inline double integrate(const double dt, std::size_t beg, std::size_t end,
   const auto end_mid = std::min(max_grid - Nquad, end);
   const auto start_mid = std::max(Nquad, beg);
 
-  double Rint_ends = qip::inner_product_sub(beg, Nquad, cq, f1, rest...);
+  const double Rint_ends =
+      helper::end_corrections(beg, end, end_mid, [&](auto i) {
+        return qip::multiply_at(i, f1, rest...);
+      });
 
   const double Rint_mid =
-      qip::inner_product_sub(start_mid, end_mid, f1, rest...);
+      helper::product_sum(start_mid, end_mid, f1.data(), rest.data()...);
+
+  return (Rint_mid + dq_inv * Rint_ends) * dt;
+}
+
+//------------------------------------------------------------------------------
+//! Fused integral of two products that share factors, in a single pass:
+//! Int[(a1*a2 + b1*b2)*w1*w2*...]. Same as (but ~twice as fast as):
+//! integrate(dt,beg,end,a1,a2,w...) + integrate(dt,beg,end,b1,b2,w...).
+//! e.g., radial integral of two Dirac spinors: a=f, b=g, w=drdu
+template <typename... Args>
+inline double integrate_fg(const double dt, std::size_t beg, std::size_t end,
+                           const std::vector<double> &a1,
+                           const std::vector<double> &a2,
+                           const std::vector<double> &b1,
+                           const std::vector<double> &b2,
+                           const Args &... w) {
+  [[maybe_unused]] auto sp = IO::Profile::safeProfiler(__func__);
+
+  const auto max_grid = a1.size();
+  if (end == 0)
+    end = max_grid;
+  const auto end_mid = std::min(max_grid - Nquad, end);
+  const auto start_mid = std::max(Nquad, beg);
+
+  const double Rint_ends =
+      helper::end_corrections(beg, end, end_mid, [&](auto i) {
+        return (a1[i] * a2[i] + b1[i] * b2[i]) * (1.0 * ... * w[i]);
+      });
+
+  const double Rint_mid =
+      helper::product_pairs_sum(start_mid, end_mid, a1.data(), a2.data(),
+                                b1.data(), b2.data(), w.data()...);
 
-  for (auto i = end_mid; i < end; ++i) {
-    Rint_ends += cq[end_mid + Nquad - i - 1] * qip::multiply_at(i, f1, rest...);
-  }
   return (Rint_mid + dq_inv * Rint_ends) * dt;
 }
 
@@ -119,8 +119,10 @@ void HFAnomaly(const IO::InputBlock &input, const Wavefunction &wf) {
     const auto gI = nuc.mu / nuc.I_N;
     std::cout << "\nA = " << nuc.A << ", gI = " << gI
               << ", r_rms = " << nuc.r_rms << "\n";
-    wfA.hartreeFockCore("HartreeFock", 0.0, wf.coreConfiguration_nice());
-    wfA.hartreeFockValence(DiracSpinor::state_config(wf.valence));
+    // Start from reference orbitals: only nuclear potential has changed
+    wfA.hartreeFockCore(wf);
+    wfA.valence = wf.valence;
+    wfA.hartreeFockValence();
     wfA.basis = wf.basis; // OK??
     //  wfA.formBasis({"50spd30f", 60, 7, 0.0, 0.0, 30.0, false});
 
@@ -132,13 +134,17 @@ void HFAnomaly(const IO::InputBlock &input, const Wavefunction &wf) {
         rpas2{nullptr};
     if (rpa) {
       std::cout << "Including RPA (diagram method) - must have basis\n";
-      // OK ? or need run with new basis!?
-      rpap2 = std::make_unique<ExternalField::DiagramRPA>(
-          hpt2.get(), wfA.basis, wfA.core, wfA.identity());
+      // Same basis as reference: re-use W matrices
+      rpap2 =
+          std::make_unique<ExternalField::DiagramRPA>(hpt2.get(), rpap.get());
       rpab2 =
           std::make_unique<ExternalField::DiagramRPA>(hbl2.get(), rpap.get());
       rpas2 =
           std::make_unique<ExternalField::DiagramRPA>(hsp2.get(), rpap.get());
+      // don't start from scratch: use reference isotope's solutions
+      rpap2->grab_tam(rpap.get());
+      rpab2->grab_tam(rpab.get());
+      rpas2->grab_tam(rpas.get());
       std::cout << "Solving RPA core for point, ball, SP:\n";
       rpap2->solve_core(0.0, 100, true);
       rpab2->solve_core(0.0, 100, true);
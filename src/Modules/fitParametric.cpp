@@ -1,4 +1,5 @@
 #include "Modules/fitParametric.hpp"
+#include "DiracODE/DiracODE.hpp"
 #include "HF/HartreeFock.hpp"
 #include "IO/InputBlock.hpp"
 #include "Maths/Grid.hpp"
@@ -7,8 +8,12 @@
 #include "Physics/Parametric_potentials.hpp"
 #include "Physics/PhysConst_constants.hpp"
 #include "Wavefunction/Wavefunction.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <numeric>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace Module {
@@ -20,7 +25,7 @@ void fitParametric(const IO::InputBlock &input, const Wavefunction &wf) {
   auto which_states = input.get<std::string>("statesToFit", "core");
   auto which_method = input.get<std::string>("method", "Green");
 
-  auto fit_worst = input.get("fitWorst", true);
+  auto fit_worst = input.get("fitWorst", false);
 
   std::vector<AtomData::DiracSEnken> states;
   // bool fit_worst = true; // XXX update to be input?
@@ -94,6 +99,156 @@ void fitParametric(const IO::InputBlock &input, const Wavefunction &wf) {
   return;
 }
 
+//******************************************************************************
+// Nuclear + parametric (Green or Tietz) potential
+static std::vector<double> parametric_v(const Wavefunction &wf, int Z,
+                                        double H, double d, bool green) {
+  auto v = wf.vnuc;
+  for (auto i = 0ul; i < v.size(); ++i) {
+    const auto r = wf.rgrid->r[i];
+    v[i] += green ? Parametric::green(Z, r, H, d)
+                  : Parametric::tietz(Z, r, H, d);
+  }
+  return v;
+}
+
+//------------------------------------------------------------------------------
+// Solves each state, for each set of parameters {H, d} in Hds (all in
+// parallel). Orbitals Fs are used as the starting guesses.
+static std::vector<std::vector<DiracSpinor>>
+solve_states(const std::vector<DiracSpinor> &Fs,
+             const std::vector<std::pair<double, double>> &Hds,
+             const Wavefunction &wf, int Z, bool green) {
+  std::vector<std::vector<double>> vs;
+  for (const auto &[H, d] : Hds) {
+    vs.push_back(parametric_v(wf, Z, H, d, green));
+  }
+  std::vector<std::vector<DiracSpinor>> out(Hds.size(), Fs);
+  const auto num_states = Fs.size();
+#pragma omp parallel for schedule(dynamic)
+  for (auto i = 0ul; i < Hds.size() * num_states; ++i) {
+    auto &Fa = out[i / num_states][i % num_states];
+    DiracODE::boundState(Fa, Fa.en, vs[i / num_states], {}, wf.alpha);
+  }
+  return out;
+}
+
+//------------------------------------------------------------------------------
+// Relative energy residuals, (e - e_target)/(e + e_target)
+static std::vector<double>
+residuals(const std::vector<DiracSpinor> &Fs,
+          const std::vector<AtomData::DiracSEnken> &states) {
+  std::vector<double> res;
+  for (auto i = 0ul; i < Fs.size(); ++i) {
+    res.push_back((Fs[i].en - states[i].en) / (Fs[i].en + states[i].en));
+  }
+  return res;
+}
+
+//******************************************************************************
+std::tuple<double, double> FitParametric::performFit_LM(
+    const std::vector<AtomData::DiracSEnken> &states, int Z,
+    const GridParameters &gp, const Nuclear::Parameters &nuc_params,
+    bool green) {
+
+  // Same bounds as grid search
+  const double Hmin = 0.05, Hmax = 15.0;
+  const double dmin = 0.01, dmax = 5.0;
+  const double eps = 1.0e-7;
+  const int max_its = 100;
+
+  // Only used for grid, nuclear potential, alpha
+  const Wavefunction wf(gp, nuc_params);
+
+  // Start from default parameters. nb: Tietz(g,t) = Tietz(H,d)
+  double H{0.0}, d{0.0};
+  if (green)
+    Parametric::defaultGreenCore(Z, H, d);
+  else
+    Parametric::defaultTietz(Z, d, H);
+  H = std::clamp(H, Hmin, Hmax);
+  d = std::clamp(d, dmin, dmax);
+
+  // Orbitals at current best parameters: starting guess for each solve
+  std::vector<DiracSpinor> Fs;
+  for (const auto &[n, k, en] : states) {
+    Fs.emplace_back(n, k, wf.rgrid);
+    Fs.back().en = en;
+  }
+  Fs = solve_states(Fs, {{H, d}}, wf, Z, green).front();
+  auto res = residuals(Fs, states);
+  auto chi2 = std::inner_product(cbegin(res), cend(res), cbegin(res), 0.0);
+  int num_sweeps = 1;
+
+  double lambda = 1.0e-3;
+  int it = 0;
+  for (; it < max_its; ++it) {
+    // Jacobian, by (forward) finite-difference; both columns in parallel
+    const auto hH = 1.0e-5 * std::max(H, 1.0);
+    const auto hd = 1.0e-5 * std::max(d, 1.0);
+    const auto Fds = solve_states(Fs, {{H + hH, d}, {H, d + hd}}, wf, Z, green);
+    num_sweeps += 2;
+    const auto rH = residuals(Fds[0], states);
+    const auto rd = residuals(Fds[1], states);
+
+    // Normal equations: (J^T J + lambda diag(J^T J)) dp = -J^T r
+    double a00{0.0}, a01{0.0}, a11{0.0}, g0{0.0}, g1{0.0};
+    for (auto i = 0ul; i < res.size(); ++i) {
+      const auto jH = (rH[i] - res[i]) / hH;
+      const auto jd = (rd[i] - res[i]) / hd;
+      a00 += jH * jH;
+      a01 += jH * jd;
+      a11 += jd * jd;
+      g0 += jH * res[i];
+      g1 += jd * res[i];
+    }
+
+    // Increase damping until step reduces chi^2
+    bool improved = false;
+    double dH{0.0}, dd{0.0};
+    for (int tries = 0; tries < 20 && !improved; ++tries) {
+      const auto b00 = a00 * (1.0 + lambda);
+      const auto b11 = a11 * (1.0 + lambda);
+      const auto det = b00 * b11 - a01 * a01;
+      if (det == 0.0) {
+        lambda *= 10.0;
+        continue;
+      }
+      const auto H_new =
+          std::clamp(H - (b11 * g0 - a01 * g1) / det, Hmin, Hmax);
+      const auto d_new =
+          std::clamp(d - (b00 * g1 - a01 * g0) / det, dmin, dmax);
+      auto Fs_new = solve_states(Fs, {{H_new, d_new}}, wf, Z, green).front();
+      ++num_sweeps;
+      const auto res_new = residuals(Fs_new, states);
+      const auto chi2_new = std::inner_product(cbegin(res_new), cend(res_new),
+                                               cbegin(res_new), 0.0);
+      if (chi2_new < chi2) {
+        dH = H_new - H;
+        dd = d_new - d;
+        H = H_new;
+        d = d_new;
+        Fs = std::move(Fs_new);
+        res = res_new;
+        chi2 = chi2_new;
+        lambda = std::max(0.1 * lambda, 1.0e-12);
+        improved = true;
+      } else {
+        lambda *= 10.0;
+      }
+    }
+
+    printf("%2i %6.4f %6.4f  %.1e  %.1e\n", it, H, d, std::sqrt(chi2),
+           std::max(std::abs(dH), std::abs(dd)));
+    if (!improved || (std::abs(dH) < eps * H && std::abs(dd) < eps * d))
+      break;
+  }
+  std::cout << "Converged after " << it + 1 << " iterations (" << num_sweeps
+            << " ODE sweeps)\n";
+
+  return std::make_tuple(H, d);
+}
+
 //******************************************************************************
 std::tuple<double, double>
 FitParametric::performFit(const std::vector<AtomData::DiracSEnken> &states,
@@ -107,10 +262,12 @@ FitParametric::performFit(const std::vector<AtomData::DiracSEnken> &states,
   else
     std::cout << "Teitz ";
   std::cout << "potential).\n";
-  if (fit_worst)
-    std::cout << "Fitting for worst state.\n";
-  else
-    std::cout << "Fitting by sum of (relative) squares.\n";
+  if (!fit_worst) {
+    std::cout << "Fitting by sum of (relative) squares "
+                 "(Levenberg-Marquardt).\n";
+    return performFit_LM(states, Z, gp, nuc_params, green);
+  }
+  std::cout << "Fitting for worst state.\n";
 
   // convergence parameters for finding best-fit H and d (or t and g)
   double eps = 1.e-6;
@@ -146,23 +303,12 @@ FitParametric::performFit(const std::vector<AtomData::DiracSEnken> &states,
             wf.vdir.push_back(Parametric::tietz(Z, r, H, d));
         // fits for the worst state
         double fx = 0;
-        if (fit_worst) {
-          for (std::size_t ns = 0; ns < states.size(); ns++) {
-            wf.solveNewValence(states[ns].n, states[ns].k, states[ns].en);
-            auto fx2 = fabs((wf.valence[ns].en - states[ns].en) /
-                            (wf.valence[ns].en + states[ns].en));
-            if (fx2 > fx)
-              fx = fx2;
-          }
-        } else {
-          // sum-of-squares
-          for (std::size_t ns = 0; ns < states.size(); ns++) {
-            wf.solveNewValence(states[ns].n, states[ns].k, states[ns].en);
-            // fx += std::pow(wf.orbitals[ns].en - states[ns].en, 2);
-            fx += std::pow((wf.valence[ns].en - states[ns].en) /
-                               (wf.valence[ns].en + states[ns].en),
-                           2);
-          }
+        for (std::size_t ns = 0; ns < states.size(); ns++) {
+          wf.solveNewValence(states[ns].n, states[ns].k, states[ns].en);
+          auto fx2 = fabs((wf.valence[ns].en - states[ns].en) /
+                          (wf.valence[ns].en + states[ns].en));
+          if (fx2 > fx)
+            fx = fx2;
         }
         array[n][m][0] = fx;
         array[n][m][1] = H;
@@ -19,10 +19,19 @@ namespace Module {
 void fitParametric(const IO::InputBlock &input, const Wavefunction &wf);
 
 namespace FitParametric {
+//! Finds best-fit parameters: Levenberg-Marquardt (least squares), or
+//! iterated grid search if fit_worst (minimise worst relative error)
 std::tuple<double, double>
 performFit(const std::vector<AtomData::DiracSEnken> &states, int Z,
            const GridParameters &gp, const Nuclear::Parameters &nuc_params,
            bool green, bool fit_worst);
-}
+
+//! Levenberg-Marquardt least-squares fit to relative energy errors.
+//! Finite-difference Jacobian; previous orbitals used as starting guesses
+std::tuple<double, double>
+performFit_LM(const std::vector<AtomData::DiracSEnken> &states, int Z,
+              const GridParameters &gp, const Nuclear::Parameters &nuc_params,
+              bool green);
+} // namespace FitParametric
 
 } // namespace Module
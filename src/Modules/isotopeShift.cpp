@@ -1,70 +1,135 @@
 #include "Modules/isotopeShift.hpp"
 #include "DiracOperator/Operators.hpp" //For E1 operator
+#include "ExternalField/TDHF.hpp"
+#include "HF/HartreeFock.hpp"
 #include "IO/InputBlock.hpp"
 #include "Physics/PhysConst_constants.hpp" // For GHz unit conversion
 #include "Wavefunction/Wavefunction.hpp"
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <gsl/gsl_fit.h>
 
 namespace Module {
 
-void fieldShift(const IO::InputBlock &, const Wavefunction &wfA) {
+//******************************************************************************
+// Nuclear potential (Fermi distribution, t=2.3 fm), for given rms radius
+static std::vector<double> fermi_vnuc(const Wavefunction &wf, double r_rms) {
+  const auto t = 2.3;
+  return Nuclear::fermiNuclearPotential(
+      wf.Znuc(), t, Nuclear::c_hdr_formula_rrms_t(r_rms, t), wf.rgrid->r);
+}
+
+//******************************************************************************
+std::vector<double> fieldShift_perturbative(const Wavefunction &wf, bool rpa) {
+  // F = d(E)/d(<r^2>) = <v|dV/d<r^2>|v> (+ core polarisation)
+  const auto r0 = wf.get_rrms();
+  const auto del = 1.0e-3 * r0;
+  const auto dr2 = (r0 + del) * (r0 + del) - (r0 - del) * (r0 - del);
+  auto dVdr2 = fermi_vnuc(wf, r0 + del);
+  const auto vm = fermi_vnuc(wf, r0 - del);
+  for (auto i = 0ul; i < dVdr2.size(); ++i) {
+    dVdr2[i] = (dVdr2[i] - vm[i]) / dr2;
+  }
+  const DiracOperator::ScalarOperator h(dVdr2);
+  auto dV = ExternalField::TDHF(&h, wf.getHF());
+  if (rpa)
+    dV.solve_core(0.0, 100, false);
+
+  std::vector<double> F;
+  for (const auto &Fv : wf.valence) {
+    const auto c = PhysConst::Hartree_GHz / h.angularF(Fv.k, Fv.k);
+    F.push_back(c * (h.reducedME(Fv, Fv) + (rpa ? dV.dV(Fv, Fv) : 0.0)));
+  }
+  return F;
+}
+
+//******************************************************************************
+std::vector<double> fieldShift_dE(const Wavefunction &wfA, double r_rmsB) {
+  // Differs from reference (wfA) only by the nuclear potential: start from the
+  // reference core/valence orbitals, rather than from scratch. Sigma is shared
+  // (read-only), not copied: many of these may run in parallel
+  const auto hf_method = HF::parseMethod(wfA.getHF()->method());
+  const auto x_Breit = wfA.getHF()->x_Breit();
+  Wavefunction wfB(wfA);
+  wfB.vnuc = fermi_vnuc(wfA, r_rmsB);
+  wfB.shareSigma(wfA);
+  wfB.hartreeFockCore(wfA, hf_method, x_Breit, 0.0, false);
+  wfB.hartreeFockValence("", false);
+  wfB.hartreeFockBrueckner(false);
+  std::vector<double> dE;
+  for (auto i = 0ul; i < wfB.valence.size(); ++i) {
+    dE.push_back((wfB.valence[i].en - wfA.valence[i].en) *
+                 PhysConst::Hartree_GHz);
+  }
+  return dE;
+}
+
+//******************************************************************************
+void fieldShift(const IO::InputBlock &input, const Wavefunction &wfA) {
 
-  Wavefunction wfB(wfA.rgrid->params(), wfA.get_nuclearParameters(),
-                   wfA.alpha / PhysConst::alpha);
+  input.checkBlock({"method", "num_steps"});
+
+  // method: "finiteField": solve HF (+Brueckner) for a range of nuclear radii,
+  // fit E(<r^2>); "perturbative": first-order in delta V_nuc (incl. RPA)
+  const auto method = input.get<std::string>("method", "finiteField");
+  const auto num_steps = input.get("num_steps", 10);
 
   std::cout << "\n";
   IO::print_line();
   std::cout << "Calculating field shift corrections for \n"
-            << wfA.atom() << ", " << wfA.nuclearParams() << "\nvs.\n"
-            << wfB.atom() << ", " << wfB.nuclearParams() << "\n\n";
-
-  wfB.copySigma(wfA.getSigma());
-  wfB.hartreeFockCore("HartreeFock", 0.0, wfA.coreConfiguration());
-  wfB.hartreeFockValence(DiracSpinor::state_config(wfA.valence));
-  wfB.hartreeFockBrueckner();
-  wfB.printValence();
+            << wfA.atom() << ", " << wfA.nuclearParams() << "\n";
 
-  const auto vA = wfA.vnuc;
-  const auto vB = wfB.vnuc;
+  if (wfA.getHF() == nullptr) {
+    std::cout << "Fail: need HF core\n";
+    return;
+  }
 
-  const auto r0B = wfB.get_rrms();
+  const auto r0B = wfA.get_rrms();
 
-  // const auto enB0 = wfB.valence[0].en;
-  std::vector<std::vector<std::pair<double, double>>> data(wfB.valence.size());
-  // data.emplace_back(0.0, 0.0);
+  if (method == "perturbative") {
+    const auto F0s = fieldShift_perturbative(wfA, false);
+    const auto Fs = fieldShift_perturbative(wfA, true);
+    std::cout << "\nPerturbative (incl. RPA): F = d(E)/d(<r^2>)\n";
+    for (auto i = 0ul; i < wfA.valence.size(); ++i) {
+      std::cout << wfA.valence[i].symbol() << " "
+                << "F = " << Fs[i] << " GHz/fm^2 (no RPA: " << F0s[i]
+                << ")\n";
+    }
+    return;
+  }
 
   const auto min_pc = 0.001;
   const auto max_pc = 1.0;
-  const auto num_steps = 10;
-
   const auto delta_grid = Grid(r0B * min_pc / 100.0, r0B * max_pc / 100.0,
-                               num_steps, GridType::logarithmic);
-  const auto t = 2.3;
-
-  std::cout << "\n   r_rms (fm),   del(r),    del(r^2),    dE (GHz)\n";
+                               std::size_t(num_steps), GridType::logarithmic);
+  std::vector<double> rBs;
   for (const auto pm : {-1, 1}) {
     for (const auto del : delta_grid.r) {
-      const auto rB = r0B + pm * del;
-      const auto dr2 = r0B * r0B - rB * rB;
-
-      wfB.vnuc = Nuclear::fermiNuclearPotential(
-          wfB.Znuc(), t, Nuclear::c_hdr_formula_rrms_t(rB, t), wfA.rgrid->r);
-
-      wfB.hartreeFockCore("", 0.0, "", 0.0, false);
-      wfB.hartreeFockValence("", false);
-      wfB.hartreeFockBrueckner(false);
-
-      for (auto i = 0ul; i < wfB.valence.size(); ++i) {
-        const auto &Fv = wfB.valence[i];
-        const auto &Fv0 = *wfA.getState(Fv.n, Fv.k);
-        const auto dE = -(Fv.en - Fv0.en) * PhysConst::Hartree_GHz;
-
-        printf("%4s, %7.5f, %+7.5f, %11.4e, %11.4e\n", Fv.shortSymbol().c_str(),
-               rB, rB - r0B, dr2, dE);
-        auto &data_v = data[i];
-        data_v.emplace_back(dr2, dE);
-      }
+      rBs.push_back(r0B + pm * del);
+    }
+  }
+
+  // dEs[ip][i] : energy shift of i-th valence state for ip-th point
+  // Points are independent, so run in parallel
+  std::vector<std::vector<double>> dEs(rBs.size());
+#pragma omp parallel for schedule(dynamic)
+  for (auto ip = 0ul; ip < rBs.size(); ++ip) {
+    dEs[ip] = fieldShift_dE(wfA, rBs[ip]);
+  }
+
+  std::vector<std::vector<std::pair<double, double>>> data(wfA.valence.size());
+  std::cout << "\n   r_rms (fm),   del(r),    del(r^2),    dE (GHz)\n";
+  for (auto ip = 0ul; ip < rBs.size(); ++ip) {
+    const auto rB = rBs[ip];
+    const auto dr2 = r0B * r0B - rB * rB;
+    for (auto i = 0ul; i < wfA.valence.size(); ++i) {
+      const auto &Fv = wfA.valence[i];
+      const auto dE = -dEs[ip][i];
+      printf("%4s, %7.5f, %+7.5f, %11.4e, %11.4e\n", Fv.shortSymbol().c_str(),
+             rB, rB - r0B, dr2, dE);
+      data[i].emplace_back(dr2, dE);
     }
   }
 
@@ -76,8 +141,8 @@ void fieldShift(const IO::InputBlock &, const Wavefunction &wfA) {
 
   auto sorter = [](auto p1, auto p2) { return p1.first < p2.first; };
 
-  for (auto i = 0ul; i < wfB.valence.size(); ++i) {
-    const auto &Fv = wfB.valence[i];
+  for (auto i = 0ul; i < wfA.valence.size(); ++i) {
+    const auto &Fv = wfA.valence[i];
     auto &data_v = data[i];
     std::sort(begin(data_v), end(data_v), sorter);
 
@@ -1,4 +1,5 @@
 #pragma once
+#include <vector>
 
 // Forward declare classes:
 class Wavefunction;
@@ -9,6 +10,25 @@ class InputBlock;
 namespace Module {
 
 //! Calculates field shift: F = d(E)/d(<r^2>)
+/*! @details
+method=finiteField (default): solves HF (+ Brueckner, if Sigma exists) for
+num_steps nuclear radii either side of reference, and fits. Each point starts
+from the reference orbitals; points run in parallel, sharing one (read-only)
+Sigma.
+method=perturbative: first-order in change of nuclear potential, including
+core polarisation (TDHF): no scan needed.
+*/
 void fieldShift(const IO::InputBlock &input, const Wavefunction &wf);
 
+//! Perturbative field shift, F = d(E)/d(<r^2>) [GHz/fm^2], for each valence
+//! state: first-order in change of nuclear potential; rpa=true includes core
+//! polarisation (TDHF). wf must have HF core
+std::vector<double> fieldShift_perturbative(const Wavefunction &wf,
+                                            bool rpa = true);
+
+//! Change in valence energies, E_B - E_A [GHz], when nuclear rms radius is
+//! changed to r_rmsB (Fermi distribution). Solves HF (+ Brueckner, if wfA has
+//! Sigma), starting from wfA's orbitals. wfA's Sigma is shared, not copied
+std::vector<double> fieldShift_dE(const Wavefunction &wfA, double r_rmsB);
+
 } // namespace Module
@@ -0,0 +1,48 @@
+#pragma once
+#include "Modules/isotopeShift.hpp"
+#include "Wavefunction/Wavefunction.hpp"
+#include "qip/Check.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace UnitTest {
+
+//******************************************************************************
+//! Unit tests for field shift: perturbative (incl. RPA) vs. full HF
+//! re-calculation for small change in nuclear radius (finite difference)
+bool FieldShift(std::ostream &obuff) {
+  bool pass = true;
+
+  Wavefunction wf({3000, 1.0e-6, 150.0, 20.0, "loglinear", -1.0},
+                  {"Cs", 133, "Fermi", -1.0, -1.0}, 1.0);
+  wf.hartreeFockCore("HartreeFock", 0.0, "[Xe]");
+  wf.hartreeFockValence("6sp");
+
+  const auto F_pt = Module::fieldShift_perturbative(wf);
+
+  // Symmetric finite difference: F = d(E)/d(<r^2>)
+  const auto r0 = wf.get_rrms();
+  const auto del = 0.01 * r0;
+  const auto dr2 = (r0 + del) * (r0 + del) - (r0 - del) * (r0 - del);
+  const auto dEp = Module::fieldShift_dE(wf, r0 + del);
+  const auto dEm = Module::fieldShift_dE(wf, r0 - del);
+
+  double worst = 0.0;
+  std::string worst_s;
+  for (auto i = 0ul; i < wf.valence.size(); ++i) {
+    const auto F_ff = (dEp[i] - dEm[i]) / dr2;
+    const auto eps = std::abs((F_pt[i] - F_ff) / F_ff);
+    if (!(eps < worst)) {
+      worst = eps;
+      worst_s = wf.valence[i].shortSymbol();
+    }
+  }
+  pass &= qip::check_value(&obuff, "F: perturbative vs finite " + worst_s,
+                           worst, 0.0, 1.0e-4);
+
+  return pass;
+}
+
+} // namespace UnitTest
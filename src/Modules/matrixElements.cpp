@@ -207,7 +207,11 @@ void structureRad(const IO::InputBlock &input, const Wavefunction &wf) {
   MBPT::StructureRad sr(wf.basis, en_core, {n_min, n_max});
   std::cout << std::flush;
 
-  // Loop through all valence states, calc SR+NS
+  // List of all {w,v} pairs, and the states used for the legs
+  struct WV {
+    const DiracSpinor *w, *v, *ws, *vs, *wp, *vp;
+  };
+  std::vector<WV> wv_list;
   for (const auto &v : wf.valence) {
     for (const auto &w : wf.valence) {
       if (h->isZero(w.k, v.k))
@@ -229,46 +233,69 @@ void structureRad(const IO::InputBlock &input, const Wavefunction &wf) {
       }
       const auto *vp = spline_legs ? &*vs : &v;
       const auto *wp = spline_legs ? &*ws : &w;
+      const auto *wsp = ws == cend(wf.basis) ? &w : &*ws;
+      const auto *vsp = vs == cend(wf.basis) ? &v : &*vs;
+      wv_list.push_back({&w, &v, wsp, vsp, wp, vp});
+    }
+  }
 
-      IO::ChronoTimer timer("time");
+  const auto print_result = [&](const WV &x,
+                                const MBPT::StructureRad::SRN &res) {
+    const auto &[w, v, ws, vs, wp, vp] = x;
+    std::cout << "\n" << h->rme_symbol(*w, *v) << ":\n";
+
+    // Zeroth-order MEs:
+    const auto twvs = h->reducedME(*ws, *vs); // splines here
+    const auto twv = h->reducedME(*w, *v);
+    const auto dvs = dV ? twvs + dV->dV(*wp, *vp) : 0.0;
+    const auto dv = dV ? twv + dV->dV(*w, *v) : 0.0;
+    printer("t(spl)", twvs, dvs);
+    printer("t(val)", twv, dv);
+
+    const auto &[tb, c, n] = res;
+    // "Top" + "Bottom" SR terms:
+    printer("SR(TB)", tb.first, tb.second);
+    // "Centre" SR term:
+    printer("SR(C)", c.first, c.second);
+
+    std::cout << "========\n";
+    printer("SR", tb.first + c.first, tb.second + c.second);
+
+    // "Normalisation"
+    printer("Norm", n.first, n.second);
+
+    const auto tot = tb.first + c.first + n.first;
+    const auto tot_dv = tb.second + c.second + n.second;
+    printer("Total", tot, tot_dv);
+    printer("as %", 100.0 * tot / twvs, 100.0 * tot_dv / dvs);
+  };
 
-      std::cout << "\n" << h->rme_symbol(w, v) << ":\n";
+  if (!eachFreqQ) {
+    // Same omega for all: calculate all pairs at once (much faster)
+    IO::ChronoTimer timer("time");
+    std::vector<std::pair<const DiracSpinor *, const DiracSpinor *>> wv;
+    for (const auto &x : wv_list)
+      wv.emplace_back(x.wp, x.vp);
+    const auto result = sr.srn(h.get(), wv, const_omega, dV.get());
+    for (std::size_t i = 0; i < wv_list.size(); ++i)
+      print_result(wv_list[i], result[i]);
+  } else {
+    for (const auto &x : wv_list) {
+      IO::ChronoTimer timer("time");
 
-      const auto ww = eachFreqQ ? std::abs(wp->en - vp->en) : const_omega;
-      if (eachFreqQ && h->freqDependantQ) {
+      // Operator (and RPA) depend on frequency: update for each pair
+      const auto ww = std::abs(x.wp->en - x.vp->en);
+      if (h->freqDependantQ) {
         h->updateFrequency(ww);
       }
-      if (eachFreqQ && rpaQ) {
+      if (rpaQ) {
         if (dV->get_eps() > 1.0e-3)
           dV->clear();
         dV->solve_core(ww);
       }
 
-      // Zeroth-order MEs:
-      const auto twvs = h->reducedME(*ws, *vs); // splines here
-      const auto twv = h->reducedME(w, v);
-      const auto dvs = dV ? twvs + dV->dV(*wp, *vp) : 0.0;
-      const auto dv = dV ? twv + dV->dV(w, v) : 0.0;
-      printer("t(spl)", twvs, dvs);
-      printer("t(val)", twv, dv);
-
-      // "Top" + "Bottom" SR terms:
-      const auto [tb, tb_dv] = sr.srTB(h.get(), *wp, *vp, ww, dV.get());
-      printer("SR(TB)", tb, tb_dv);
-      // "Centre" SR term:
-      const auto [c, c_dv] = sr.srC(h.get(), *wp, *vp, dV.get());
-      printer("SR(C)", c, c_dv);
-
-      std::cout << "========\n";
-      printer("SR", tb + c, tb_dv + c_dv);
-
-      // "Normalisation"
-      const auto [n, n_dv] = sr.norm(h.get(), *wp, *vp, dV.get());
-      printer("Norm", n, n_dv);
-
-      printer("Total", tb + c + n, tb_dv + c_dv + n_dv);
-      printer("as %", 100.0 * (tb + c + n) / twvs,
-              100.0 * (tb_dv + c_dv + n_dv) / dvs);
+      const auto result = sr.srn(h.get(), {{x.wp, x.vp}}, ww, dV.get());
+      print_result(x, result.front());
     }
   }
   std::cout << "\n";
@@ -312,19 +339,27 @@ void calculateLifetimes(const IO::InputBlock &input, const Wavefunction &wf) {
     std::string state;
     double tau;
   };
+  // Bare reduced matrix elements, <n||h||a>, between all valence states
+  const auto e1_na = doE1 ? he1.reducedME_matrix(wf.valence, wf.valence)
+                          : std::vector<std::vector<double>>{};
+  const auto e2_na = doE2 ? he2.reducedME_matrix(wf.valence, wf.valence)
+                          : std::vector<std::vector<double>>{};
+
   std::vector<Data> data;
-  for (const auto &Fa : wf.valence) {
+  for (auto ia = 0ul; ia < wf.valence.size(); ++ia) {
+    const auto &Fa = wf.valence[ia];
     std::cout << "\n" << Fa.symbol() << "\n";
     auto Gamma = 0.0;
 
     if (doE1) {
-      for (const auto &Fn : wf.valence) {
+      for (auto in = 0ul; in < wf.valence.size(); ++in) {
+        const auto &Fn = wf.valence[in];
         if (Fn.en >= Fa.en || he1.isZero(Fn.k, Fa.k))
           continue;
         const auto w = Fa.en - Fn.en;
         if (rpaQ)
           dVE1.solve_core(w, 40);
-        auto d = he1.reducedME(Fn, Fa) + dVE1.dV(Fn, Fa);
+        auto d = e1_na[in][ia] + dVE1.dV(Fn, Fa);
         if (sr) {
           // include SR.
           const auto [tb, tbx] = sr->srTB(&he1, Fn, Fa);
@@ -340,13 +375,14 @@ void calculateLifetimes(const IO::InputBlock &input, const Wavefunction &wf) {
       }
     }
     if (doE2) {
-      for (const auto &Fn : wf.valence) {
+      for (auto in = 0ul; in < wf.valence.size(); ++in) {
+        const auto &Fn = wf.valence[in];
         if (Fn.en >= Fa.en || he2.isZero(Fn.k, Fa.k))
           continue;
         const auto w = Fa.en - Fn.en;
         if (rpaQ)
           dVE2.solve_core(w, 40);
-        const auto d = he2.reducedME(Fn, Fa) + dVE2.dV(Fn, Fa);
+        const auto d = e2_na[in][ia] + dVE2.dV(Fn, Fa);
         const auto g_n = (1.0 / 15) * w * w * w * w * w * d * d / (Fa.twojp1());
         Gamma += g_n * alpha2;
         std::cout << "  E2 --> " << Fn.symbol() << ": ";
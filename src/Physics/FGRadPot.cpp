@@ -19,6 +19,19 @@ static inline double E1(double x) {
   return gsl_sf_expint_E1(x);
 }
 
+//------------------------------------------------------------------------------
+// Owns a GSL integration workspace (so it can be kept, e.g., thread_local)
+class IntWorkspace {
+  gsl_integration_workspace *m_wrk;
+
+public:
+  IntWorkspace(std::size_t n) : m_wrk(gsl_integration_workspace_alloc(n)) {}
+  ~IntWorkspace() { gsl_integration_workspace_free(m_wrk); }
+  IntWorkspace(const IntWorkspace &) = delete;
+  IntWorkspace &operator=(const IntWorkspace &) = delete;
+  gsl_integration_workspace *get() { return m_wrk; }
+};
+
 //------------------------------------------------------------------------------
 // Calculates x * std::cosh(x) - sinh(x) accounting for low-x instability
 static inline double xCoshxMinusSinhx(double x) {
@@ -88,8 +101,9 @@ double t_integral(double (*f)(double, void *), std::vector<double> params,
 
   double result{0.0};
   double abs_err{0.0};
-  gsl_integration_workspace *gsl_int_wrk =
-      gsl_integration_workspace_alloc(max_num_subintvls + 1);
+  // One workspace per thread, re-used between calls
+  static thread_local IntWorkspace workspace(max_num_subintvls + 1);
+  gsl_integration_workspace *gsl_int_wrk = workspace.get();
 
   double rel_err_targ = rel_err_lim;
   while (rel_err_targ < 1.0) {
@@ -110,7 +124,6 @@ double t_integral(double (*f)(double, void *), std::vector<double> params,
       rel_err_targ *= 5.0;
     }
   }
-  gsl_integration_workspace_free(gsl_int_wrk);
 
   return result;
 }
@@ -298,11 +311,9 @@ double Q_MLVP(double r, double rN) {
   // integrate using gsl
   double result{0.0};
   double abs_err{0.0};
-  gsl_integration_workspace *gsl_int_wrk =
-      gsl_integration_workspace_alloc(max_num_subintvls + 1);
+  static thread_local IntWorkspace workspace(max_num_subintvls + 1);
   gsl_integration_qagiu(&f_gsl, 1.0, abs_err_lim, rel_err_lim,
-                        max_num_subintvls, gsl_int_wrk, &result, &abs_err);
-  gsl_integration_workspace_free(gsl_int_wrk);
+                        max_num_subintvls, workspace.get(), &result, &abs_err);
 
   return result;
 }
@@ -93,16 +93,12 @@ bool RadPot::read_write(const std::vector<double> &r, IO::FRW::RoW rw) {
   if (readQ && !grid_same) {
     std::cout << "Interpolating QED rad-pot onto current grid.\n";
 
-    if (!mVu.empty())
-      mVu = Interpolator::interpolate(t_r, mVu, r);
-    if (!mVh.empty())
-      mVh = Interpolator::interpolate(t_r, mVh, r);
-    if (!mVl.empty())
-      mVl = Interpolator::interpolate(t_r, mVl, r);
-    if (!mHm.empty())
-      mHm = Interpolator::interpolate(t_r, mHm, r);
-    if (!mVwk.empty())
-      mVwk = Interpolator::interpolate(t_r, mVwk, r);
+    // Same grids for each potential: set up interpolation once
+    const Interpolator::Plan interp(t_r, r);
+    for (auto *v : {&mVu, &mVh, &mVl, &mHm, &mVwk}) {
+      if (!v->empty())
+        *v = interp(*v);
+    }
   }
 
   return true;
@@ -118,17 +114,17 @@ void RadPot::form_potentials(const std::vector<double> &r) {
     std::cout << "with Rn = " << m_rN * PhysConst::aB_fm << "fm\n";
   }
 
+  // Uehling, magnetic, and high-freq SE each require a t integral at each r;
+  // these are tabulated (eps for SE_h limited by accuracy of its t integral)
   if (m_f.u != 0.0) {
     if (print)
-      std::cout << "Uehling; scale=" << m_f.u << "\n";
-    mVu = fill(FGRP::V_Uehling, r);
+      std::cout << "Uehling; scale=" << m_f.u << std::flush;
+    mVu = fill_table(FGRP::V_Uehling, r, 1.0e-9);
   }
   if (m_f.h != 0.0) {
     if (print)
-      std::cout << "Self-energy (high freq); scale=" << m_f.h << "\n";
-    const auto stride = std::max(r.size() / 400, 2ul);
-    // Stride of 5 with 2000 points
-    mVh = fill(FGRP::V_SEh, r, stride);
+      std::cout << "Self-energy (high freq); scale=" << m_f.h << std::flush;
+    mVh = fill_table(FGRP::V_SEh, r, 1.0e-3, 32);
   }
   if (m_f.l != 0.0) {
     if (print)
@@ -137,8 +133,8 @@ void RadPot::form_potentials(const std::vector<double> &r) {
   }
   if (m_f.m != 0.0) {
     if (print)
-      std::cout << "Self-energy (magnetic); scale=" << m_f.m << "\n";
-    mHm = fill(FGRP::H_Magnetic, r);
+      std::cout << "Self-energy (magnetic); scale=" << m_f.m << std::flush;
+    mHm = fill_table(FGRP::H_Magnetic, r, 1.0e-9);
   }
   if (m_f.wk != 0.0) {
     if (print)
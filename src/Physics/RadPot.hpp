@@ -1,10 +1,12 @@
 #pragma once
 #include "FGRadPot.hpp"
 #include "IO/FRW_fileReadWrite.hpp"
+#include "Maths/ChebyshevTable.hpp"
 #include "Maths/Interpolator.hpp"
 #include "Physics/PhysConst_constants.hpp"
 #include "qip/Vector.hpp"
 #include <algorithm>
+#include <cstdio>
 #include <vector>
 
 namespace QED {
@@ -57,13 +59,20 @@ public:
   //! Constructor: will build potential
   /*! @details
     rcut is maxum radius (atomic units) to calc potential for.
+    Potentials are tabulated (see form_potentials), which is fast; reading from
+    and writing to the .qed file is optional (do_readwrite).
   */
   RadPot(const std::vector<double> &r, double Z, double rN = 0.0,
          double rcut = 0.0, Scale f = {1.0, 1.0, 1.0, 1.0, 0.0}, Xl xl = {},
-         bool tprint = true, bool do_readwrite = true);
+         bool tprint = true, bool do_readwrite = false);
 
   bool read_write(const std::vector<double> &r, IO::FRW::RoW rw);
 
+  //! Forms the potentials.
+  /*! @details The expensive potentials (Uehling, high-freq. and magnetic SE,
+  each an integral over t at every r) are evaluated only at Chebyshev nodes (in
+  ln r), and tabulated (see ChebyshevTable); the rest directly.
+  */
   void form_potentials(const std::vector<double> &r);
 
   //! Returns entire electric part of potential
@@ -80,21 +89,33 @@ public:
   template <typename Func>
   std::vector<double> fill(Func f, const std::vector<double> &r,
                            std::size_t stride);
+
+  //! As fill(), but f evaluated only on Chebyshev nodes, then tabulated
+  template <typename Func>
+  std::vector<double> fill_table(Func f, const std::vector<double> &r,
+                                 double eps, std::size_t max_segments = 512);
+
+private:
+  std::size_t icut(const std::vector<double> &r) const;
 };
 
 //****************************************************************************
+//******************************************************************************
+inline std::size_t RadPot::icut(const std::vector<double> &r) const {
+  const auto rcut = m_rcut == 0.0 ? r.back() : m_rcut;
+  // index for r cut-off
+  return std::size_t(std::distance(
+      begin(r),
+      std::find_if(begin(r), end(r), [rcut](auto ri) { return ri > rcut; })));
+}
+
 //******************************************************************************
 template <typename Func>
 std::vector<double> RadPot::fill(Func f, const std::vector<double> &r) {
   std::vector<double> v;
   v.resize(r.size());
 
-  const auto rcut = m_rcut == 0.0 ? r.back() : m_rcut;
-
-  // index for r cut-off
-  const auto icut = std::size_t(std::distance(
-      begin(r),
-      std::find_if(begin(r), end(r), [rcut](auto ri) { return ri > rcut; })));
+  const auto icut = this->icut(r);
 
 #pragma omp parallel for
   for (auto i = 0ul; i < icut; ++i) {
@@ -109,14 +130,7 @@ template <typename Func>
 std::vector<double> RadPot::fill(Func f, const std::vector<double> &r,
                                  std::size_t stride) {
 
-  const auto rcut = m_rcut == 0.0 ? r.back() : m_rcut;
-
-  // index for r cut-off
-  const auto icut =
-      std::size_t(std::distance(
-          begin(r), std::find_if(begin(r), end(r),
-                                 [rcut](auto ri) { return ri > rcut; }))) /
-      stride;
+  const auto icut = this->icut(r) / stride;
 
   std::vector<double> tv, tr;
   tv.resize(icut);
@@ -131,4 +145,31 @@ std::vector<double> RadPot::fill(Func f, const std::vector<double> &r,
   return stride == 1 ? tv : Interpolator::interpolate(tr, tv, r);
 }
 
+//******************************************************************************
+template <typename Func>
+std::vector<double> RadPot::fill_table(Func f, const std::vector<double> &r,
+                                       double eps, std::size_t max_segments) {
+  std::vector<double> v(r.size());
+
+  const auto icut = this->icut(r);
+  if (icut == 0)
+    return v;
+
+  // nuclear radius is a break-point (functions not smooth there)
+  const auto Z = m_Z;
+  const auto rN = m_rN;
+  const ChebyshevTable table([&](double x) { return f(Z, x, rN); }, r.front(),
+                             r[icut - 1], eps, {rN}, max_segments);
+  if (print) {
+    printf(" (tabulated: %zu points, eps~%.0e)\n", table.num_evaluations(),
+           table.error_estimate());
+  }
+
+  for (auto i = 0ul; i < icut; ++i) {
+    // nb: Use H -> H+V (instead of H-> H-V), so change sign!
+    v[i] = -table(r[i]);
+  }
+  return v;
+}
+
 } // namespace QED
@@ -1,5 +1,6 @@
 #pragma once
 #include "DiracOperator/Operators.hpp"
+#include "Maths/ChebyshevTable.hpp"
 #include "Physics/RadPot.hpp"
 #include "Wavefunction/Wavefunction.hpp"
 #include "qip/Check.hpp"
@@ -360,6 +361,32 @@ bool helper::FGRadPot(std::ostream &obuff) {
         qip::check_value(&obuff, "FGRP::Int (cf Mathem)", worst, 0.0, 1.0e-6);
   }
 
+  {
+    // Tabulated (Chebyshev) potentials, compared to direct t integrals
+    const double z = 55.0;
+    const double rN = 1.0e-4;
+    const auto r_list =
+        std::vector{1.3e-6, 2.7e-5, 0.9e-4, 1.1e-4, 7.3e-4, 4.1e-3, 1.9e-2};
+    const auto tab_vs_direct = [&](auto f, double eps) {
+      const ChebyshevTable table([&](double r) { return f(z, r, rN); },
+                                 1.0e-6, 5.0, eps, {rN});
+      std::vector<double> tab, direct;
+      for (auto r : r_list) {
+        tab.push_back(table(r));
+        direct.push_back(f(z, r, rN));
+      }
+      return qip::compare_eps(tab, direct).first;
+    };
+    pass &= qip::check_value(&obuff, "FGRP::Ueh tabulated",
+                             tab_vs_direct(FGRP::V_Uehling, 1.0e-9), 0.0,
+                             1.0e-6);
+    pass &= qip::check_value(&obuff, "FGRP::Mag tabulated",
+                             tab_vs_direct(FGRP::H_Magnetic, 1.0e-9), 0.0,
+                             1.0e-6);
+    pass &= qip::check_value(&obuff, "FGRP::SEh tabulated",
+                             tab_vs_direct(FGRP::V_SEh, 1.0e-3), 0.0, 1.0e-3);
+  }
+
   return pass;
 }
 
@@ -2,11 +2,13 @@
 #include "DiracOperator/Operators.hpp"
 #include "Wavefunction/BSplineBasis.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
+#include "Wavefunction/OrbitalSet.hpp"
 #include "Wavefunction/Wavefunction.hpp"
 #include "qip/Check.hpp"
 #include "qip/Maths.hpp"
 #include "qip/Vector.hpp"
 #include <algorithm>
+#include <cmath>
 #include <string>
 
 namespace UnitTest {
@@ -136,6 +138,59 @@ bool BSplineBasis(std::ostream &obuff) {
 
     const auto [eps, str] = DiracSpinor::check_ortho(basis, basis);
     pass &= qip::check_value(&obuff, label + " orth ", eps, 0.0, 3.0e-8);
+
+    { // OrbitalSet: overlaps (as matrix product) vs. Fa*Fb
+      const OrbitalSet set(basis);
+      const auto o = set.overlaps(set);
+      double worst = 0.0;
+      for (std::size_t i = 0; i < basis.size(); ++i) {
+        for (std::size_t j = 0; j < basis.size(); ++j) {
+          const auto ab = basis[i].k == basis[j].k ? basis[i] * basis[j] : 0.0;
+          worst = std::max(worst, std::abs(o[i * basis.size() + j] - ab));
+        }
+      }
+      pass &= qip::check_value(&obuff, label + " OrbitalSet <a|b>", worst,
+                               0.0, 1.0e-14);
+
+      // Spoil orthogonality, then restore (both methods)
+      auto orbs = basis;
+      for (std::size_t i = 1; i < orbs.size(); ++i) {
+        if (orbs[i].k == orbs[i - 1].k)
+          orbs[i] += 0.01 * orbs[i - 1];
+      }
+      for (const auto method :
+           {OrbitalSet::Ortho::GramSchmidt, OrbitalSet::Ortho::Lowdin}) {
+        OrbitalSet set2(orbs);
+        set2.orthonormalise(method);
+        const auto [eps2, str2] = set2.check_ortho(set2);
+        const auto name = method == OrbitalSet::Ortho::Lowdin ? "Lowdin" : "GS";
+        pass &= qip::check_value(&obuff, label + " OrbitalSet " + name + " " +
+                                             str2,
+                                 eps2, 0.0, 1.0e-12);
+      }
+
+      // Linearly dependent set (an orbital repeated): must fail, and leave
+      // orbitals unchanged (rather than abort, or give NaNs)
+      auto orbs_dep = basis;
+      orbs_dep.push_back(basis.front());
+      for (const auto method :
+           {OrbitalSet::Ortho::GramSchmidt, OrbitalSet::Ortho::Lowdin}) {
+        OrbitalSet set3(orbs_dep);
+        const auto ok = set3.orthonormalise(method);
+        const auto out = set3.spinors();
+        double worst3 = ok ? 1.0 : 0.0;
+        for (std::size_t i = 0; i < out.size(); ++i) {
+          const auto dF = out[i] - orbs_dep[i];
+          const auto del = std::abs(dF * dF);
+          if (!(del < worst3))
+            worst3 = del;
+        }
+        const auto name = method == OrbitalSet::Ortho::Lowdin ? "Lowdin" : "GS";
+        pass &= qip::check_value(&obuff,
+                                 label + " OrbitalSet " + name + " dependent",
+                                 worst3, 0.0, 1.0e-20);
+      }
+    }
     {
       const auto tkr = SplineBasis::sumrule_TKR(basis, wf.rgrid->r, false);
 
@@ -126,9 +126,8 @@ double operator*(const DiracSpinor &lhs, const DiracSpinor &rhs) {
   const auto imin = std::max(lhs.p0, rhs.p0);
   const auto imax = std::min(lhs.pinf, rhs.pinf);
   const auto &dr = lhs.rgrid->drdu;
-  return (NumCalc::integrate(1, imin, imax, lhs.f, rhs.f, dr) +
-          NumCalc::integrate(1, imin, imax, lhs.g, rhs.g, dr)) *
-         lhs.rgrid->du;
+  return NumCalc::integrate_fg(lhs.rgrid->du, imin, imax, lhs.f, rhs.f, lhs.g,
+                               rhs.g, dr);
 }
 
 DiracSpinor &DiracSpinor::operator+=(const DiracSpinor &rhs) {
@@ -161,26 +160,43 @@ DiracSpinor &DiracSpinor::operator-=(const DiracSpinor &rhs) {
   return *this;
 }
 
-DiracSpinor operator+(DiracSpinor lhs, const DiracSpinor &rhs) {
+DiracSpinor operator+(DiracSpinor &&lhs, const DiracSpinor &rhs) {
   lhs += rhs;
-  return lhs;
+  return std::move(lhs);
 }
-DiracSpinor operator-(DiracSpinor lhs, const DiracSpinor &rhs) {
+DiracSpinor operator-(DiracSpinor &&lhs, const DiracSpinor &rhs) {
   lhs -= rhs;
-  return lhs;
+  return std::move(lhs);
+}
+DiracSpinor operator+(const DiracSpinor &lhs, DiracSpinor &&rhs) {
+  rhs += lhs;
+  return std::move(rhs);
+}
+DiracSpinor operator-(const DiracSpinor &lhs, DiracSpinor &&rhs) {
+  // rhs -> lhs - rhs (in one pass)
+  rhs = -1.0 * rhs + lhs;
+  return std::move(rhs);
+}
+DiracSpinor operator+(DiracSpinor &&lhs, DiracSpinor &&rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+DiracSpinor operator-(DiracSpinor &&lhs, DiracSpinor &&rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
 }
 
 DiracSpinor &DiracSpinor::operator*=(const double x) {
   scale(x);
   return *this;
 }
-DiracSpinor operator*(DiracSpinor lhs, const double x) {
+DiracSpinor operator*(DiracSpinor &&lhs, const double x) {
   lhs *= x;
-  return lhs;
+  return std::move(lhs);
 }
-DiracSpinor operator*(const double x, DiracSpinor rhs) {
+DiracSpinor operator*(const double x, DiracSpinor &&rhs) {
   rhs *= x;
-  return rhs;
+  return std::move(rhs);
 }
 
 DiracSpinor &DiracSpinor::operator*=(const std::vector<double> &v) {
@@ -205,6 +221,19 @@ DiracSpinor &DiracSpinor::operator=(const DiracSpinor &other) {
   return *this;
 }
 
+DiracSpinor &DiracSpinor::operator=(DiracSpinor &&other) {
+  assert(*this == other); // same n and kappa
+  if (this != &other) {
+    en = other.en;
+    f = std::move(other.f);
+    g = std::move(other.g);
+    p0 = other.p0;
+    pinf = other.pinf;
+    occ_frac = other.occ_frac;
+  }
+  return *this;
+}
+
 //******************************************************************************
 //******************************************************************************
 // comparitor overloads:
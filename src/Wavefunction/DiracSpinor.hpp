@@ -1,9 +1,16 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 class Grid;
+class DiracSpinor;
+template <std::size_t N> struct DiracSpinorLinComb;
+//! Single term in linear combination of spinors: {coeficient, spinor}
+using DiracSpinorTerm = std::pair<double, const DiracSpinor *>;
 
 //******************************************************************************
 /*!
@@ -34,9 +41,20 @@ Takes in constant n and k=kappa values + grid
   - Fa * Fb = <Fa|Fb>
   - Fa == Fb returns true if {na,ka}=={nb,kb}
   - Fa > Fb : first compares n, and then kappa (via kappa_index)
-  - Fa +/- Fb : Adds/subtracts the two spinors (and updates p0/pinf)
-  - You can make copies: auto Fnew = Fa
+  - Fa +/- Fb : Adds/subtracts the two spinors (and updates p0/pinf). The
+    result has n, kappa, en of Fa, unless only Fb is a temporary (e.g.,
+    Fa - f(x)): it is then evaluated in place, in Fb, and keeps Fb's n, kappa,
+    en. Note: this is a change; previously, the result always had Fa's
+  - You can make copies: DiracSpinor Fnew = Fa
   - And you can re-asign: Fb = Fa (provided Fa and Fb have same n and kappa!)
+
+\par Linear combinations
+  - Sums and scalar multiples of spinors (e.g., a * Fa + b * Fb) are not
+    evaluated immediately; they return a DiracSpinorLinComb (expression
+    template), which is evaluated in a single pass, without temporaries, when
+    assigned to a DiracSpinor (=, +=, -=, or construction)
+  - Therefore, use DiracSpinor (not auto) to store the result:
+    DiracSpinor Fc = Fa + Fb; (auto Fc = Fa + Fb is the un-evaluated sum)
 */
 class DiracSpinor {
 
@@ -120,12 +138,27 @@ public:
 
   DiracSpinor &operator+=(const DiracSpinor &rhs);
   DiracSpinor &operator-=(const DiracSpinor &rhs);
-  friend DiracSpinor operator+(DiracSpinor lhs, const DiracSpinor &rhs);
-  friend DiracSpinor operator-(DiracSpinor lhs, const DiracSpinor &rhs);
+  friend DiracSpinorLinComb<2> operator+(const DiracSpinor &lhs,
+                                         const DiracSpinor &rhs);
+  friend DiracSpinorLinComb<2> operator-(const DiracSpinor &lhs,
+                                         const DiracSpinor &rhs);
+  // If either is a temporary, evaluated immediately, in place (re-using its
+  // storage); the result keeps the n, kappa, en of that temporary (so, for
+  // Fa +/- tmp, those of tmp, not of Fa)
+  friend DiracSpinor operator+(DiracSpinor &&lhs, const DiracSpinor &rhs);
+  friend DiracSpinor operator-(DiracSpinor &&lhs, const DiracSpinor &rhs);
+  friend DiracSpinor operator+(const DiracSpinor &lhs, DiracSpinor &&rhs);
+  friend DiracSpinor operator-(const DiracSpinor &lhs, DiracSpinor &&rhs);
+  friend DiracSpinor operator+(DiracSpinor &&lhs, DiracSpinor &&rhs);
+  friend DiracSpinor operator-(DiracSpinor &&lhs, DiracSpinor &&rhs);
 
   DiracSpinor &operator*=(const double x);
-  friend DiracSpinor operator*(DiracSpinor lhs, const double x);
-  friend DiracSpinor operator*(const double x, DiracSpinor rhs);
+  friend DiracSpinorLinComb<1> operator*(const DiracSpinor &lhs,
+                                         const double x);
+  friend DiracSpinorLinComb<1> operator*(const double x,
+                                         const DiracSpinor &rhs);
+  friend DiracSpinor operator*(DiracSpinor &&lhs, const double x);
+  friend DiracSpinor operator*(const double x, DiracSpinor &&rhs);
 
   DiracSpinor &operator*=(const std::vector<double> &v);
   friend DiracSpinor operator*(const std::vector<double> &v, DiracSpinor rhs);
@@ -168,6 +201,250 @@ public:
   static int max_kindex(const std::vector<DiracSpinor> &orbs);
 
   DiracSpinor &operator=(const DiracSpinor &);
+  DiracSpinor &operator=(DiracSpinor &&);
   DiracSpinor(const DiracSpinor &) = default;
+  DiracSpinor(DiracSpinor &&) = default;
   ~DiracSpinor() = default;
+
+  //! Evaluates linear combination; n, kappa, en etc. taken from first term
+  template <std::size_t N> DiracSpinor(const DiracSpinorLinComb<N> &expr);
+  //! Evaluates linear combination (in place, no allocation)
+  template <std::size_t N>
+  DiracSpinor &operator=(const DiracSpinorLinComb<N> &expr);
+  template <std::size_t N>
+  DiracSpinor &operator+=(const DiracSpinorLinComb<N> &expr);
+  template <std::size_t N>
+  DiracSpinor &operator-=(const DiracSpinorLinComb<N> &expr);
+
+private:
+  // *this = sum_i c_i F_i, in a single pass. Safe if *this is one of F_i
+  template <std::size_t N>
+  void assign_terms(const std::array<DiracSpinorTerm, N> &terms);
 };
+
+//******************************************************************************
+//! Lazy (un-evaluated) linear combination of DiracSpinors: sum_i c_i * F_i
+/*! @details
+Expression template: stores only the coeficients, and pointers to the spinors.
+Evaluated (in one pass over grid, with no temporaries) only when assigned to a
+DiracSpinor. See DiracSpinor.
+ - Only ever points to lvalues: any operation involving a temporary
+   DiracSpinor is evaluated immediately, so the references cannot dangle
+ - Evaluation is lazy: the referenced spinors must not be modified before it
+   is evaluated
+*/
+template <std::size_t N> struct DiracSpinorLinComb {
+  static_assert(N > 0);
+  std::array<DiracSpinorTerm, N> terms{};
+
+  //! The first spinor (defines n, kappa, en etc. of result)
+  const DiracSpinor &first() const { return *terms.front().second; }
+
+  //! Returns {this, sign*rhs}: a linear combination of N+M terms
+  template <std::size_t M>
+  DiracSpinorLinComb<N + M> join(double sign,
+                                 const DiracSpinorLinComb<M> &rhs) const {
+    DiracSpinorLinComb<N + M> out{};
+    std::copy(cbegin(terms), cend(terms), begin(out.terms));
+    for (std::size_t i = 0; i < M; ++i) {
+      out.terms[N + i] = {sign * rhs.terms[i].first, rhs.terms[i].second};
+    }
+    return out;
+  }
+
+  friend DiracSpinorLinComb operator*(double x, DiracSpinorLinComb rhs) {
+    for (auto &[c, F] : rhs.terms)
+      c *= x;
+    return rhs;
+  }
+  friend DiracSpinorLinComb operator*(const DiracSpinorLinComb &lhs,
+                                      double x) {
+    return x * lhs;
+  }
+
+  template <std::size_t M>
+  friend DiracSpinorLinComb<N + M> operator+(const DiracSpinorLinComb &lhs,
+                                             const DiracSpinorLinComb<M> &rhs) {
+    return lhs.join(1.0, rhs);
+  }
+  template <std::size_t M>
+  friend DiracSpinorLinComb<N + M> operator-(const DiracSpinorLinComb &lhs,
+                                             const DiracSpinorLinComb<M> &rhs) {
+    return lhs.join(-1.0, rhs);
+  }
+
+  friend DiracSpinorLinComb<N + 1> operator+(const DiracSpinorLinComb &lhs,
+                                             const DiracSpinor &rhs) {
+    return lhs.join(1.0, DiracSpinorLinComb<1>{{{{1.0, &rhs}}}});
+  }
+  friend DiracSpinorLinComb<N + 1> operator-(const DiracSpinorLinComb &lhs,
+                                             const DiracSpinor &rhs) {
+    return lhs.join(-1.0, DiracSpinorLinComb<1>{{{{1.0, &rhs}}}});
+  }
+  friend DiracSpinorLinComb<N + 1> operator+(const DiracSpinor &lhs,
+                                             const DiracSpinorLinComb &rhs) {
+    return DiracSpinorLinComb<1>{{{{1.0, &lhs}}}}.join(1.0, rhs);
+  }
+  friend DiracSpinorLinComb<N + 1> operator-(const DiracSpinor &lhs,
+                                             const DiracSpinorLinComb &rhs) {
+    return DiracSpinorLinComb<1>{{{{1.0, &lhs}}}}.join(-1.0, rhs);
+  }
+
+  // Temporaries: evaluate immediately (in place)
+  friend DiracSpinor operator+(const DiracSpinorLinComb &lhs,
+                               DiracSpinor &&rhs) {
+    rhs += lhs;
+    return std::move(rhs);
+  }
+  friend DiracSpinor operator-(const DiracSpinorLinComb &lhs,
+                               DiracSpinor &&rhs) {
+    rhs = -1.0 * rhs + lhs;
+    return std::move(rhs);
+  }
+  friend DiracSpinor operator+(DiracSpinor &&lhs,
+                               const DiracSpinorLinComb &rhs) {
+    lhs += rhs;
+    return std::move(lhs);
+  }
+  friend DiracSpinor operator-(DiracSpinor &&lhs,
+                               const DiracSpinorLinComb &rhs) {
+    lhs -= rhs;
+    return std::move(lhs);
+  }
+
+  //! Inner product, <lhs|rhs> (evaluates linear combination)
+  friend double operator*(const DiracSpinorLinComb &lhs,
+                          const DiracSpinor &rhs) {
+    return DiracSpinor(lhs) * rhs;
+  }
+  friend double operator*(const DiracSpinor &lhs,
+                          const DiracSpinorLinComb &rhs) {
+    return lhs * DiracSpinor(rhs);
+  }
+  template <std::size_t M>
+  friend double operator*(const DiracSpinorLinComb &lhs,
+                          const DiracSpinorLinComb<M> &rhs) {
+    return DiracSpinor(lhs) * DiracSpinor(rhs);
+  }
+  friend DiracSpinor operator*(const std::vector<double> &v,
+                               const DiracSpinorLinComb &rhs) {
+    return v * DiracSpinor(rhs);
+  }
+};
+
+//******************************************************************************
+inline DiracSpinorLinComb<1> operator*(const double x, const DiracSpinor &rhs) {
+  return {{{{x, &rhs}}}};
+}
+inline DiracSpinorLinComb<1> operator*(const DiracSpinor &lhs, const double x) {
+  return {{{{x, &lhs}}}};
+}
+inline DiracSpinorLinComb<2> operator+(const DiracSpinor &lhs,
+                                       const DiracSpinor &rhs) {
+  return {{{{1.0, &lhs}, {1.0, &rhs}}}};
+}
+inline DiracSpinorLinComb<2> operator-(const DiracSpinor &lhs,
+                                       const DiracSpinor &rhs) {
+  return {{{{1.0, &lhs}, {-1.0, &rhs}}}};
+}
+
+//------------------------------------------------------------------------------
+template <std::size_t N>
+DiracSpinor::DiracSpinor(const DiracSpinorLinComb<N> &expr)
+    : DiracSpinor(expr.first().n, expr.first().k, expr.first().rgrid) {
+  const auto &F0 = expr.first();
+  en = F0.en;
+  its = F0.its;
+  eps = F0.eps;
+  occ_frac = F0.occ_frac;
+  // Newly constructed: already zero everywhere
+  pinf = 0;
+  assign_terms(expr.terms);
+}
+
+template <std::size_t N>
+DiracSpinor &DiracSpinor::operator=(const DiracSpinorLinComb<N> &expr) {
+  const auto &F0 = expr.first();
+  assert(*this == F0); // same n and kappa
+  en = F0.en;
+  occ_frac = F0.occ_frac;
+  assign_terms(expr.terms);
+  return *this;
+}
+
+template <std::size_t N>
+DiracSpinor &DiracSpinor::operator+=(const DiracSpinorLinComb<N> &expr) {
+  assign_terms(DiracSpinorLinComb<1>{{{{1.0, this}}}}.join(1.0, expr).terms);
+  return *this;
+}
+
+template <std::size_t N>
+DiracSpinor &DiracSpinor::operator-=(const DiracSpinorLinComb<N> &expr) {
+  assign_terms(DiracSpinorLinComb<1>{{{{1.0, this}}}}.join(-1.0, expr).terms);
+  return *this;
+}
+
+//------------------------------------------------------------------------------
+template <std::size_t N>
+void DiracSpinor::assign_terms(const std::array<DiracSpinorTerm, N> &terms) {
+  // Read everything from the terms first: *this may be one of them
+  std::array<double, N> c;
+  std::array<const double *, N> tf, tg;
+  std::array<std::size_t, N> t0, t1;
+  std::array<std::size_t, 2 * N> edges;
+  for (std::size_t j = 0; j < N; ++j) {
+    const auto &Fj = *terms[j].second;
+    assert(Fj.k == k);
+    c[j] = terms[j].first;
+    tf[j] = Fj.f.data();
+    tg[j] = Fj.g.data();
+    t0[j] = Fj.p0;
+    t1[j] = Fj.pinf;
+    edges[2 * j] = Fj.p0;
+    edges[2 * j + 1] = Fj.pinf;
+  }
+  std::sort(begin(edges), end(edges));
+  const auto new_p0 = edges.front();
+  const auto new_pinf = edges.back();
+
+  // Zero any part of old [p0,pinf) that is outside new one
+  for (std::size_t i = p0; i < std::min(pinf, new_p0); ++i) {
+    f[i] = 0.0;
+    g[i] = 0.0;
+  }
+  for (std::size_t i = std::max(p0, new_pinf); i < pinf; ++i) {
+    f[i] = 0.0;
+    g[i] = 0.0;
+  }
+
+  // Between each pair of edges, the set of non-zero terms is fixed:
+  // evaluate all of them together, point-by-point (so aliasing is safe)
+  for (std::size_t s = 0; s + 1 < edges.size(); ++s) {
+    const auto i0 = edges[s];
+    const auto i1 = edges[s + 1];
+    if (i0 == i1)
+      continue;
+    std::array<double, N> ca;
+    std::array<const double *, N> fa, ga;
+    std::size_t na = 0;
+    for (std::size_t j = 0; j < N; ++j) {
+      if (t0[j] <= i0 && t1[j] >= i1) {
+        ca[na] = c[j];
+        fa[na] = tf[j];
+        ga[na] = tg[j];
+        ++na;
+      }
+    }
+    for (std::size_t i = i0; i < i1; ++i) {
+      double fi = 0.0, gi = 0.0;
+      for (std::size_t a = 0; a < na; ++a) {
+        fi += ca[a] * fa[a][i];
+        gi += ca[a] * ga[a][i];
+      }
+      f[i] = fi;
+      g[i] = gi;
+    }
+  }
+  p0 = new_p0;
+  pinf = new_pinf;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "Maths/Grid.hpp"
+#include "Physics/PhysConst_constants.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include "qip/Check.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace UnitTest {
+
+//******************************************************************************
+//! Unit tests for DiracSpinor arithmetic: linear combinations (lazy, expression
+//! templates) and operations involving temporaries, vs. explicit point-by-point
+bool DiracSpinorOps(std::ostream &obuff) {
+  bool pass = true;
+
+  const double Zeff = 5.0;
+  const auto num_grid_points{2000ul};
+  const auto grid = std::make_shared<const Grid>(
+      1.0e-7, 100.0, num_grid_points, GridType::loglinear, 10.0);
+
+  auto Fa = DiracSpinor::exactHlike(2, -1, grid, Zeff, PhysConst::alpha);
+  auto Fb = DiracSpinor::exactHlike(3, -1, grid, Zeff, PhysConst::alpha);
+  // different extents, to test p0/pinf handling:
+  Fa.pinf = num_grid_points / 2;
+  Fa.zero_boundaries();
+  Fb.p0 = 10;
+  Fb.zero_boundaries();
+
+  // ca * F1 + cb * F2, point-by-point: {f..., g...}
+  const auto expected = [&](double ca, const DiracSpinor &F1, double cb,
+                            const DiracSpinor &F2) {
+    std::vector<double> fg;
+    for (std::size_t i = 0; i < num_grid_points; ++i)
+      fg.push_back(ca * F1.f[i] + cb * F2.f[i]);
+    for (std::size_t i = 0; i < num_grid_points; ++i)
+      fg.push_back(ca * F1.g[i] + cb * F2.g[i]);
+    return fg;
+  };
+  // Worst deviation from expected; also checks the extent covers both
+  const auto worst = [&](const DiracSpinor &F, const std::vector<double> &fg) {
+    double eps = double(F.p0) + double(num_grid_points - F.pinf);
+    for (std::size_t i = 0; i < num_grid_points; ++i) {
+      eps = std::max({eps, std::abs(F.f[i] - fg[i]),
+                      std::abs(F.g[i] - fg[i + num_grid_points])});
+    }
+    return eps;
+  };
+
+  const auto ca = 0.3, cb = -1.7;
+
+  { // Lazy linear combinations
+    const auto fg_ab = expected(ca, Fa, cb, Fb);
+    const DiracSpinor Fc = ca * Fa + cb * Fb;
+    // In-place, with aliasing (Fb is also on rhs):
+    auto Fd = Fb;
+    Fd = cb * Fd + ca * Fa;
+    const auto eps = std::max(worst(Fc, fg_ab), worst(Fd, fg_ab));
+    pass &= qip::check_value(&obuff, "DiracSpinor a*Fa+b*Fb", eps, 0.0,
+                             1.0e-15);
+  }
+
+  { // Temporaries: evaluated immediately, in place
+    // copy() gives a temporary (rvalue) DiracSpinor
+    const auto copy = [](const DiracSpinor &F) { return F; };
+    double eps = 0.0;
+    eps = std::max(eps, worst(copy(Fa) + Fb, expected(1.0, Fa, 1.0, Fb)));
+    eps = std::max(eps, worst(copy(Fa) - Fb, expected(1.0, Fa, -1.0, Fb)));
+    eps = std::max(eps, worst(Fa + copy(Fb), expected(1.0, Fa, 1.0, Fb)));
+    eps = std::max(eps, worst(Fa - copy(Fb), expected(1.0, Fa, -1.0, Fb)));
+    eps = std::max(eps,
+                   worst(copy(Fa) - copy(Fb), expected(1.0, Fa, -1.0, Fb)));
+    eps = std::max(eps, worst(ca * Fa + copy(Fb), expected(ca, Fa, 1.0, Fb)));
+    eps = std::max(eps, worst(ca * Fa - copy(Fb), expected(ca, Fa, -1.0, Fb)));
+    eps = std::max(eps, worst(copy(Fa) - cb * Fb, expected(1.0, Fa, -cb, Fb)));
+    pass &= qip::check_value(&obuff, "DiracSpinor temporaries", eps, 0.0,
+                             1.0e-15);
+  }
+
+  { // Result has n, kappa, en of Fa, unless only Fb is a temporary
+    const auto copy = [](const DiracSpinor &F) { return F; };
+    const auto same = [](const DiracSpinor &F, const DiracSpinor &G) {
+      return F.n == G.n && F.k == G.k && F.en == G.en;
+    };
+    int num_wrong = 0;
+    num_wrong += !same(DiracSpinor(Fa - Fb), Fa);
+    num_wrong += !same(copy(Fa) - Fb, Fa);
+    num_wrong += !same(copy(Fa) - copy(Fb), Fa);
+    num_wrong += !same(Fa - copy(Fb), Fb);
+    num_wrong += !same(ca * Fa - copy(Fb), Fb);
+    pass &= qip::check_value(&obuff, "DiracSpinor temporaries: n, en",
+                             num_wrong, 0, 0);
+  }
+
+  return pass;
+}
+
+} // namespace UnitTest
@@ -130,13 +130,13 @@ public:
     auto Sab = NumCalc::integrate(1.0, min, max, Fa.g, Fb.g, drdu);
 
     const auto &v = get_v(kappa);
-    auto Vab = NumCalc::integrate(1.0, min, max, Fa.f, Fb.f, v, drdu) +
-               NumCalc::integrate(1.0, min, max, Fa.g, Fb.g, v, drdu);
+    auto Vab =
+        NumCalc::integrate_fg(1.0, min, max, Fa.f, Fb.f, Fa.g, Fb.g, v, drdu);
 
     auto V_mag = 0.0;
     if (!m_v_mag.empty())
-      V_mag = NumCalc::integrate(1.0, min, max, Fa.f, Fb.g, m_v_mag, drdu) +
-              NumCalc::integrate(1.0, min, max, Fa.g, Fb.f, m_v_mag, drdu);
+      V_mag = NumCalc::integrate_fg(1.0, min, max, Fa.f, Fb.g, Fa.g, Fb.f,
+                                    m_v_mag, drdu);
     // XXX include MAG!
 
     return (Vab - m_c * (D1m2 + 2.0 * m_c * Sab + V_mag)) * Fa.rgrid->du;
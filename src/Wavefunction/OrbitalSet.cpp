@@ -0,0 +1,316 @@
+#include "Wavefunction/OrbitalSet.hpp"
+#include "Maths/Grid.hpp"
+#include "Maths/NumCalc_quadIntegrate.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_eigen.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_linalg.h>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//******************************************************************************
+OrbitalSet::OrbitalSet(const std::vector<DiracSpinor> &orbs)
+    : m_rgrid(orbs.empty() ? nullptr : orbs.front().rgrid),
+      m_ld(orbs.empty() ? 0 : 2 * orbs.front().rgrid->num_points) {
+
+  const auto num_points = m_ld / 2;
+  const auto num_orbs = orbs.size();
+
+  // Group by kappa (stable): order of first appearance
+  for (const auto &Fa : orbs) {
+    if (!find_block(Fa.k))
+      m_blocks.push_back({Fa.k, 0, 0});
+  }
+  for (auto &b : m_blocks) {
+    b.first = m_index.size();
+    for (std::size_t i = 0; i < num_orbs; ++i) {
+      if (orbs[i].k == b.kappa)
+        m_index.push_back(i);
+    }
+    b.num = m_index.size() - b.first;
+  }
+
+  m_row.resize(num_orbs);
+  m_p0.resize(num_orbs);
+  m_pinf.resize(num_orbs);
+  m_fg.resize(num_orbs * m_ld, 0.0);
+  for (std::size_t r = 0; r < num_orbs; ++r) {
+    const auto &Fa = orbs[m_index[r]];
+    m_row[m_index[r]] = r;
+    m_p0[r] = Fa.p0;
+    m_pinf[r] = std::min(Fa.pinf, num_points);
+    auto fg = row(r);
+    std::copy(cbegin(Fa.f) + long(Fa.p0), cbegin(Fa.f) + long(m_pinf[r]),
+              fg + Fa.p0);
+    std::copy(cbegin(Fa.g) + long(Fa.p0), cbegin(Fa.g) + long(m_pinf[r]),
+              fg + num_points + Fa.p0);
+  }
+  for (const auto &Fa : orbs) {
+    m_n.push_back(Fa.n);
+    m_kappa.push_back(Fa.k);
+    m_en.push_back(Fa.en);
+    m_occ.push_back(Fa.occ_frac);
+  }
+
+  // Integration weights: identical to NumCalc::integrate
+  if (num_points > 0) {
+    using namespace NumCalc;
+    assert(num_points > 2 * Nquad);
+    m_w.resize(m_ld);
+    for (std::size_t i = 0; i < num_points; ++i) {
+      const auto c = i < Nquad                ? cq[i] * dq_inv
+                     : i >= num_points - Nquad ? cq[num_points - i - 1] * dq_inv
+                                               : 1.0;
+      m_w[i] = c * m_rgrid->drdu[i] * m_rgrid->du;
+      m_w[i + num_points] = m_w[i];
+    }
+  }
+}
+
+//******************************************************************************
+const OrbitalSet::Block *OrbitalSet::find_block(int kappa) const {
+  const auto is_kappa = [kappa](const auto &x) { return x.kappa == kappa; };
+  const auto b = std::find_if(cbegin(m_blocks), cend(m_blocks), is_kappa);
+  return b == cend(m_blocks) ? nullptr : &*b;
+}
+
+//******************************************************************************
+DiracSpinor OrbitalSet::spinor(std::size_t i) const {
+  DiracSpinor Fa(m_n[i], m_kappa[i], m_rgrid);
+  Fa.en = m_en[i];
+  Fa.occ_frac = m_occ[i];
+  const auto r = m_row[i];
+  const auto num_points = m_ld / 2;
+  Fa.p0 = m_p0[r];
+  Fa.pinf = m_pinf[r];
+  const auto fg = row(r);
+  std::copy(fg, fg + num_points, begin(Fa.f));
+  std::copy(fg + num_points, fg + m_ld, begin(Fa.g));
+  return Fa;
+}
+
+//------------------------------------------------------------------------------
+std::vector<DiracSpinor> OrbitalSet::spinors() const {
+  std::vector<DiracSpinor> out;
+  out.reserve(size());
+  for (std::size_t i = 0; i < size(); ++i)
+    out.push_back(spinor(i));
+  return out;
+}
+
+//------------------------------------------------------------------------------
+void OrbitalSet::copy_to(std::vector<DiracSpinor> *orbs) const {
+  assert(orbs->size() == size());
+  const auto num_points = m_ld / 2;
+  for (std::size_t i = 0; i < size(); ++i) {
+    auto &Fa = (*orbs)[i];
+    assert(Fa.n == m_n[i] && Fa.k == m_kappa[i]);
+    const auto r = m_row[i];
+    Fa.p0 = m_p0[r];
+    Fa.pinf = m_pinf[r];
+    const auto fg = row(r);
+    std::copy(fg, fg + num_points, begin(Fa.f));
+    std::copy(fg + num_points, fg + m_ld, begin(Fa.g));
+  }
+}
+
+//******************************************************************************
+std::vector<double> OrbitalSet::block_overlaps(const Block &bi,
+                                               const OrbitalSet &other,
+                                               const Block &bj) const {
+  // <i|j> = sum_r f_i(r) w(r) f_j(r) + (same for g) : O = A.W.B^T
+  std::vector<double> o(bi.num * bj.num);
+  if (o.empty())
+    return o;
+
+  // W.B (B: rows of other block)
+  std::vector<double> wb(other.row(bj.first), other.row(bj.first + bj.num));
+  for (std::size_t j = 0; j < bj.num; ++j) {
+    for (std::size_t x = 0; x < m_ld; ++x) {
+      wb[j * m_ld + x] *= m_w[x];
+    }
+  }
+
+  // nb: const_cast only since gsl views aren't const-correct; A not modified
+  auto A = gsl_matrix_view_array(const_cast<double *>(row(bi.first)), bi.num,
+                                 m_ld);
+  auto WB = gsl_matrix_view_array(wb.data(), bj.num, m_ld);
+  auto O = gsl_matrix_view_array(o.data(), bi.num, bj.num);
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, &A.matrix, &WB.matrix, 0.0,
+                 &O.matrix);
+  return o;
+}
+
+//------------------------------------------------------------------------------
+std::vector<double> OrbitalSet::overlaps(const OrbitalSet &other) const {
+  std::vector<double> out(size() * other.size(), 0.0);
+  if (out.empty())
+    return out;
+  assert(other.m_ld == m_ld);
+#pragma omp parallel for
+  for (std::size_t ib = 0; ib < m_blocks.size(); ++ib) {
+    const auto &bi = m_blocks[ib];
+    const auto bj = other.find_block(bi.kappa);
+    if (!bj)
+      continue;
+    const auto o = block_overlaps(bi, other, *bj);
+    for (std::size_t i = 0; i < bi.num; ++i) {
+      for (std::size_t j = 0; j < bj->num; ++j) {
+        const auto ii = m_index[bi.first + i];
+        const auto jj = other.m_index[bj->first + j];
+        out[ii * other.size() + jj] = o[i * bj->num + j];
+      }
+    }
+  }
+  return out;
+}
+
+//------------------------------------------------------------------------------
+std::pair<double, std::string>
+OrbitalSet::check_ortho(const OrbitalSet &other) const {
+  const auto o = overlaps(other);
+  double worst_del = 0.0;
+  std::size_t worst_i = 0, worst_j = 0;
+  for (std::size_t i = 0; i < size(); ++i) {
+    for (std::size_t j = 0; j < other.size(); ++j) {
+      if (m_kappa[i] != other.m_kappa[j])
+        continue;
+      const auto aa = m_n[i] == other.m_n[j];
+      const auto ab = o[i * other.size() + j];
+      const auto del = aa ? std::abs(std::abs(ab) - 1.0) : std::abs(ab);
+      if (del > worst_del) {
+        worst_del = del;
+        worst_i = i;
+        worst_j = j;
+      }
+    }
+  }
+  if (worst_del == 0.0)
+    return {0.0, ""};
+  const auto sa = DiracSpinor(m_n[worst_i], m_kappa[worst_i], m_rgrid);
+  const auto sb = DiracSpinor(other.m_n[worst_j], other.m_kappa[worst_j],
+                              other.m_rgrid);
+  return {worst_del, "<" + sa.shortSymbol() + "|" + sb.shortSymbol() + ">"};
+}
+
+//******************************************************************************
+void OrbitalSet::merge_extent(const Block &b, std::size_t p0,
+                              std::size_t pinf) {
+  for (auto r = b.first; r < b.first + b.num; ++r) {
+    p0 = std::min(p0, m_p0[r]);
+    pinf = std::max(pinf, m_pinf[r]);
+  }
+  for (auto r = b.first; r < b.first + b.num; ++r) {
+    m_p0[r] = p0;
+    m_pinf[r] = pinf;
+  }
+}
+
+//******************************************************************************
+void OrbitalSet::orthogonaliseWrt(const OrbitalSet &other) {
+  if (size() == 0 || other.size() == 0)
+    return;
+  assert(other.m_ld == m_ld);
+#pragma omp parallel for
+  for (std::size_t ib = 0; ib < m_blocks.size(); ++ib) {
+    const auto &bi = m_blocks[ib];
+    const auto bj = other.find_block(bi.kappa);
+    if (!bj || bj->num == 0)
+      continue;
+    // A -> A - O.C, with O = <a|c> = A.W.C^T
+    auto o = block_overlaps(bi, other, *bj);
+    auto A = gsl_matrix_view_array(row(bi.first), bi.num, m_ld);
+    auto C = gsl_matrix_view_array(const_cast<double *>(other.row(bj->first)),
+                                   bj->num, m_ld);
+    auto O = gsl_matrix_view_array(o.data(), bi.num, bj->num);
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, -1.0, &O.matrix, &C.matrix, 1.0,
+                   &A.matrix);
+
+    const auto p0 = *std::min_element(cbegin(other.m_p0) + long(bj->first),
+                                      cbegin(other.m_p0) +
+                                          long(bj->first + bj->num));
+    const auto pinf = *std::max_element(cbegin(other.m_pinf) + long(bj->first),
+                                        cbegin(other.m_pinf) +
+                                            long(bj->first + bj->num));
+    merge_extent(bi, p0, pinf);
+  }
+}
+
+//******************************************************************************
+bool OrbitalSet::orthonormalise(Ortho method) {
+  // If overlap matrix is not positive definite (orbitals linearly dependent),
+  // the block is left unchanged (GSL would otherwise abort on Cholesky fail)
+  std::vector<int> ok(m_blocks.size(), 1);
+  const auto gsl_handler = gsl_set_error_handler_off();
+#pragma omp parallel for
+  for (std::size_t ib = 0; ib < m_blocks.size(); ++ib) {
+    const auto &b = m_blocks[ib];
+    const auto m = b.num;
+    // Overlap (Gram) matrix: S = A.W.A^T
+    auto s = block_overlaps(b, *this, b);
+    auto S = gsl_matrix_view_array(s.data(), m, m);
+    auto A = gsl_matrix_view_array(row(b.first), m, m_ld);
+
+    if (method == Ortho::GramSchmidt) {
+      // S = L.L^T ; A -> L^{-1}.A
+      // Each pivot, L_ii^2, must be positive (relative to S_ii, round-off)
+      std::vector<double> s_ii(m);
+      for (std::size_t i = 0; i < m; ++i)
+        s_ii[i] = s[i * m + i];
+      auto pos_def = gsl_linalg_cholesky_decomp(&S.matrix) == GSL_SUCCESS;
+      for (std::size_t i = 0; i < m && pos_def; ++i)
+        pos_def = s[i * m + i] * s[i * m + i] > 1.0e-12 * s_ii[i];
+      if (!pos_def) {
+        ok[ib] = 0;
+        continue;
+      }
+      gsl_blas_dtrsm(CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, 1.0,
+                     &S.matrix, &A.matrix);
+    } else {
+      // S = U.e.U^T ; A -> S^{-1/2}.A, S^{-1/2} = U.e^{-1/2}.U^T
+      std::vector<double> e(m), u(m * m), u_e(m * m), tmp(m * m_ld);
+      auto E = gsl_vector_view_array(e.data(), m);
+      auto U = gsl_matrix_view_array(u.data(), m, m);
+      auto work = gsl_eigen_symmv_alloc(m);
+      gsl_eigen_symmv(&S.matrix, &E.vector, &U.matrix, work);
+      gsl_eigen_symmv_free(work);
+      // All eigenvalues of S must be positive (to within round-off)
+      const auto [e_min, e_max] = std::minmax_element(cbegin(e), cend(e));
+      if (m > 0 && !(*e_min > 1.0e-12 * *e_max)) {
+        ok[ib] = 0;
+        continue;
+      }
+      for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < m; ++j) {
+          u_e[i * m + j] = u[i * m + j] / std::sqrt(e[j]);
+        }
+      }
+      auto Ue = gsl_matrix_view_array(u_e.data(), m, m);
+      // nb: S no longer needed; re-use for S^{-1/2}
+      gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, &Ue.matrix, &U.matrix, 0.0,
+                     &S.matrix);
+      auto T = gsl_matrix_view_array(tmp.data(), m, m_ld);
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &S.matrix, &A.matrix,
+                     0.0, &T.matrix);
+      std::copy(cbegin(tmp), cend(tmp), row(b.first));
+    }
+    merge_extent(b, m_ld / 2, 0);
+  }
+  gsl_set_error_handler(gsl_handler);
+
+  for (std::size_t ib = 0; ib < m_blocks.size(); ++ib) {
+    if (!ok[ib])
+      std::cerr << "\nFAIL OrbitalSet::orthonormalise: overlap matrix for "
+                   "kappa="
+                << m_blocks[ib].kappa
+                << " not positive definite (orbitals linearly dependent); "
+                   "left unchanged\n";
+  }
+  return std::all_of(cbegin(ok), cend(ok), [](int x) { return x == 1; });
+}
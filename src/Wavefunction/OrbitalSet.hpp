@@ -0,0 +1,96 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+class DiracSpinor;
+class Grid;
+
+//! Stores a set of orbitals {f, g} in a single contiguous block
+/*! @details
+Each orbital is a row of one (num_orbitals) x (2*num_points) row-major matrix:
+[f(r_0),...,f(r_N-1), g(r_0),...,g(r_N-1)]; zero outside [p0, pinf). Rows are
+grouped by kappa (stable), so that orbitals of each kappa are a contiguous
+block.
+
+This allows overlaps, projections and orthonormalisation of entire sets to be
+done as matrix-matrix (BLAS-3, via gsl_blas_dgemm) operations, which is much
+faster than many individual NumCalc::integrate calls for large sets.
+
+ - The integration weights (including quadrature end-point corrections) are
+   the same as used by NumCalc::integrate, so <a|b> agrees with Fa*Fb (up to
+   round-off)
+ - Orbitals of different kappa are orthogonal (angular part); only blocks of
+   the same kappa are ever combined
+ - Orbitals are always indexed in the original order. Use spinor(i) or
+   copy_to() to get DiracSpinors back.
+*/
+class OrbitalSet {
+public:
+  //! Copies f,g of all orbitals into block
+  explicit OrbitalSet(const std::vector<DiracSpinor> &orbs);
+
+  //! Orthonormalisation method: Gram-Schmidt (Cholesky), or Lowdin
+  /*! @details GramSchmidt keeps lowest (in original order) orbitals of each
+  kappa fixed (up to normalisation); Lowdin (symmetric) modifies all orbitals
+  equally, and by least amount
+  */
+  enum class Ortho { GramSchmidt, Lowdin };
+
+  std::size_t size() const { return m_n.size(); }
+
+  //! Returns i-th orbital (original order) as a DiracSpinor [copy]
+  DiracSpinor spinor(std::size_t i) const;
+  //! Returns all orbitals as DiracSpinors [copy]
+  std::vector<DiracSpinor> spinors() const;
+  //! Copies f, g (and p0, pinf) back to orbs. orbs must be the same orbitals
+  //! (in same order) as used to construct.
+  void copy_to(std::vector<DiracSpinor> *orbs) const;
+
+  //! Overlap matrix: <i|j> for i in this, j in other. Row-major, zero for
+  //! different kappa: O[i*other.size()+j]
+  std::vector<double> overlaps(const OrbitalSet &other) const;
+
+  //! Returns worst |<a|b>| (or ||<a|a>|-1| for a=b) {val, state_names}; same
+  //! as DiracSpinor::check_ortho()
+  std::pair<double, std::string> check_ortho(const OrbitalSet &other) const;
+
+  //! |a> -> |a> - sum_c |c><c|a>, for each a in this, c in other
+  void orthogonaliseWrt(const OrbitalSet &other);
+
+  //! Forces all orbitals to be orthogonal to each other, and normal
+  //! @details Returns false if the overlap matrix of any kappa block is not
+  //! positive definite (i.e., orbitals are linearly dependent): that block is
+  //! then left unchanged, and an error is printed
+  bool orthonormalise(Ortho method = Ortho::GramSchmidt);
+
+private:
+  std::shared_ptr<const Grid> m_rgrid;
+  // length of each row (2 * num_points)
+  std::size_t m_ld;
+  // In original order: n, kappa, en, occ. frac., and row in block
+  std::vector<int> m_n{}, m_kappa{};
+  std::vector<double> m_en{}, m_occ{};
+  std::vector<std::size_t> m_row{};
+  // In row order: p0, pinf, and original index
+  std::vector<std::size_t> m_p0{}, m_pinf{}, m_index{};
+  // Blocks of same kappa: {kappa, first row, number of rows}
+  struct Block {
+    int kappa;
+    std::size_t first, num;
+  };
+  std::vector<Block> m_blocks{};
+  // Orbitals, one per row: [f, g]
+  std::vector<double> m_fg{};
+  // Integration weights (for both f and g)
+  std::vector<double> m_w{};
+
+  double *row(std::size_t r) { return m_fg.data() + r * m_ld; }
+  const double *row(std::size_t r) const { return m_fg.data() + r * m_ld; }
+  const Block *find_block(int kappa) const;
+  // Overlaps <i|j> for i in this block, j in other block: num_i x num_j
+  std::vector<double> block_overlaps(const Block &bi, const OrbitalSet &other,
+                                     const Block &bj) const;
+  // Sets p0/pinf of each row in block to extent of all rows in block (+extra)
+  void merge_extent(const Block &b, std::size_t p0, std::size_t pinf);
+};
@@ -17,6 +17,8 @@
 #include "qip/Vector.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <numeric>
 #include <sstream>
@@ -28,7 +30,14 @@
 Wavefunction::Wavefunction(const GridParameters &gridparams,
                            const Nuclear::Parameters &nuc_params,
                            double var_alpha)
-    : rgrid(std::make_shared<const Grid>(gridparams)),
+    : Wavefunction(std::make_shared<const Grid>(gridparams), nuc_params,
+                   var_alpha) {}
+
+//------------------------------------------------------------------------------
+Wavefunction::Wavefunction(std::shared_ptr<const Grid> in_grid,
+                           const Nuclear::Parameters &nuc_params,
+                           double var_alpha)
+    : rgrid(std::move(in_grid)),
       alpha(PhysConst::alpha * var_alpha),
       m_nuclear(nuc_params),
       vnuc(Nuclear::formPotential(nuc_params, rgrid->r)) {
@@ -141,14 +150,138 @@ void Wavefunction::determineCore(const std::string &str_core_in)
 void Wavefunction::hartreeFockCore(const std::string &method,
                                    const double x_Breit,
                                    const std::string &in_core, double eps_HF,
-                                   bool print) {
+                                   bool print, bool readwrite) {
   if (m_pHF == nullptr) {
     solveInitialCore(in_core, 5);
     m_pHF = std::make_unique<HF::HartreeFock>(this, HF::parseMethod(method),
                                               x_Breit, eps_HF);
   }
   m_pHF->verbose = print;
-  vdir = m_pHF->solveCore();
+
+  if (!readwrite) {
+    vdir = m_pHF->solveCore();
+    return;
+  }
+
+  const auto hash = hfCore_hash(method, x_Breit, eps_HF);
+  std::ostringstream fname;
+  fname << identity() << "_" << std::hex << hash << ".hf";
+  if (hfCore_read_write(fname.str(), hash, IO::FRW::read)) {
+    vdir = m_pHF->setCore(vdir);
+  } else {
+    vdir = m_pHF->solveCore();
+    hfCore_read_write(fname.str(), hash, IO::FRW::write);
+  }
+}
+
+//------------------------------------------------------------------------------
+std::uint64_t Wavefunction::hfCore_hash(const std::string &method,
+                                        double x_Breit, double eps_HF) const {
+  // FNV-1a hash (stable between runs/compilers, unlike std::hash)
+  std::uint64_t hash = 14695981039346656037ull;
+  const auto add = [&hash](const void *data, std::size_t size) {
+    const auto bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+  };
+  const auto add_vec = [&add](const std::vector<double> &v) {
+    add(v.data(), v.size() * sizeof(double));
+  };
+  const auto add_str = [&add](const std::string &str) {
+    add(str.data(), str.size());
+  };
+
+  // nb: vnuc includes nuclear params + any extra potential
+  add_vec(rgrid->r);
+  add_vec(vnuc);
+  add(&alpha, sizeof(alpha));
+  add(&x_Breit, sizeof(x_Breit));
+  add(&eps_HF, sizeof(eps_HF));
+  add_str(HF::parseMethod(HF::parseMethod(method)));
+  add_str(m_core_string);
+  if (qed) {
+    for (int l = 0; l <= maxCore_l(); ++l) {
+      add_vec(qed->Vel(l));
+      add_vec(qed->Hmag(l));
+    }
+  }
+  return hash;
+}
+
+//------------------------------------------------------------------------------
+bool Wavefunction::hfCore_read_write(const std::string &fname,
+                                     std::uint64_t hash, IO::FRW::RoW rw) {
+  // Increment if file format (or HF method) changes
+  constexpr int version = 1;
+
+  const auto readQ = rw == IO::FRW::read;
+  if (readQ && !IO::FRW::file_exists(fname))
+    return false;
+
+  std::fstream iofs;
+  IO::FRW::open_binary(iofs, fname, rw);
+
+  // Header: must match exactly, or don't read
+  int t_version = version;
+  std::uint64_t t_hash = hash;
+  std::size_t num_points = rgrid->num_points;
+  std::size_t num_core = core.size();
+  rw_binary(iofs, rw, t_version, t_hash, num_points, num_core);
+  if (readQ && (t_version != version || t_hash != hash ||
+                num_points != rgrid->num_points || num_core != core.size())) {
+    std::cout << "Cannot read HF core from " << fname
+              << " (mismatch); will solve + over-write\n";
+    return false;
+  }
+
+  // Orbitals: read into a copy, so core unchanged if read fails
+  auto t_core = core;
+  for (auto &Fc : t_core) {
+    int n = Fc.n, k = Fc.k;
+    rw_binary(iofs, rw, n, k);
+    if (readQ && (n != Fc.n || k != Fc.k)) {
+      std::cout << "Cannot read HF core from " << fname
+                << " (core mismatch); will solve + over-write\n";
+      return false;
+    }
+    rw_binary(iofs, rw, Fc.en, Fc.f, Fc.g, Fc.p0, Fc.pinf, Fc.its, Fc.eps,
+              Fc.occ_frac);
+  }
+  auto t_vdir = vdir;
+  rw_binary(iofs, rw, t_vdir);
+
+  if (readQ) {
+    if (!iofs.good() || t_vdir.size() != rgrid->num_points) {
+      std::cout << "Cannot read HF core from " << fname
+                << "; will solve + over-write\n";
+      return false;
+    }
+    core = std::move(t_core);
+    vdir = std::move(t_vdir);
+  }
+  std::cout << (readQ ? "Read HF core from " : "Wrote HF core to ") << fname
+            << "\n";
+  return true;
+}
+
+//******************************************************************************
+void Wavefunction::hartreeFockCore(const Wavefunction &wf0,
+                                   const std::string &method,
+                                   const double x_Breit, double eps_HF,
+                                   bool print) {
+  // nb: core orbitals point to wf0's grid (must be same as this->rgrid)
+  core = wf0.core;
+  m_core_configs = wf0.m_core_configs;
+  num_core_electrons = wf0.num_core_electrons;
+  m_core_string = wf0.m_core_string;
+  if (m_pHF == nullptr) {
+    m_pHF = std::make_unique<HF::HartreeFock>(this, HF::parseMethod(method),
+                                              x_Breit, eps_HF);
+  }
+  m_pHF->verbose = print;
+  vdir = m_pHF->solveCore(true);
 }
 
 //******************************************************************************
@@ -689,7 +822,9 @@ void Wavefunction::formSigma(
     const std::vector<double> &fk, const std::string &in_fname,
     const std::string &out_fname, const bool FeynmanQ, const bool ScreeningQ,
     const bool holeParticleQ, const int lmax, const bool GreenBasis,
-    const bool PolBasis, const double omre, double w0, double wratio) {
+    const bool PolBasis, const double omre, double w0, double wratio,
+    const bool single_precision, const double omega_tol,
+    const double rank_tol) {
   if (valence.empty())
     return;
 
@@ -705,9 +840,13 @@ void Wavefunction::formSigma(
   const auto method =
       FeynmanQ ? MBPT::Method::Feynman : MBPT::Method::Goldstone;
 
+  // Checkpoint files (for restarts) are written alongside output Sigma file
+  const auto checkpoint = out_fname == "false" ? "" : ofname;
+
   const auto sigp = MBPT::Sigma_params{
-      method, nmin_core, include_G, lmax,       GreenBasis,    PolBasis,
-      omre,   w0,        wratio,    ScreeningQ, holeParticleQ, fk};
+      method, nmin_core, include_G,  lmax,          GreenBasis, PolBasis,
+      omre,   w0,        wratio,     ScreeningQ,    holeParticleQ,
+      fk,     single_precision,      checkpoint,    omega_tol,  rank_tol};
 
   const auto subgridp = MBPT::rgrid_params{r0, rmax, std::size_t(stride)};
 
@@ -724,11 +863,13 @@ void Wavefunction::formSigma(
   }
 
   // This is for each valence state.... otherwise, just do for lowest??
+  // All are formed concurrently (sharing threads)
   if (form_matrix && !valence.empty()) {
+    std::vector<AtomData::DiracSEnken> nken_list;
     if (each_valence) {
       // calculate sigma for each valence state:
       for (const auto &Fv : valence) {
-        m_Sigma->formSigma(Fv.k, Fv.en, Fv.n);
+        nken_list.emplace_back(Fv.n, Fv.k, Fv.en);
       }
     } else {
       // calculate sigma for lowest n valence state of each kappa:
@@ -737,9 +878,10 @@ void Wavefunction::formSigma(
         auto Fv = std::find_if(cbegin(valence), cend(valence),
                                [ki](auto f) { return f.k_index() == ki; });
         if (Fv != cend(valence))
-          m_Sigma->formSigma(Fv->k, Fv->en, Fv->n);
+          nken_list.emplace_back(Fv->n, Fv->k, Fv->en);
       }
     }
+    m_Sigma->formSigma(nken_list);
   }
 
   if (!lambdas.empty()) {
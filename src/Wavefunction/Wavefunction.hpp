@@ -1,5 +1,6 @@
 #pragma once
 #include "HF/HartreeFock.hpp" // forward decl..
+#include "IO/FRW_fileReadWrite.hpp"
 #include "MBPT/CorrelationPotential.hpp"
 #include "Maths/Grid.hpp"
 #include "Physics/AtomData.hpp" // NonRelSEConfig
@@ -8,6 +9,7 @@
 #include "Physics/RadPot.hpp"
 #include "Wavefunction/BSplineBasis.hpp"
 #include "Wavefunction/DiracSpinor.hpp"
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -33,6 +35,10 @@ public:
   Wavefunction(const GridParameters &gridparams,
                const Nuclear::Parameters &nuc_params, double var_alpha = 1.0);
 
+  //! Uses existing grid (e.g., shared between several atoms)
+  Wavefunction(std::shared_ptr<const Grid> in_grid,
+               const Nuclear::Parameters &nuc_params, double var_alpha = 1.0);
+
   //! User-defined copy-constructor. Note: Does not copy HF or Sigma
   Wavefunction(const Wavefunction &wf);
   Wavefunction &operator=(const Wavefunction &) = delete;
@@ -55,7 +61,8 @@ public:
 private:
   const Nuclear::Parameters m_nuclear;
   std::unique_ptr<HF::HartreeFock> m_pHF{nullptr};
-  std::unique_ptr<MBPT::CorrelationPotential> m_Sigma{nullptr};
+  // nb: may be shared between Wavefunctions (see shareSigma)
+  std::shared_ptr<MBPT::CorrelationPotential> m_Sigma{nullptr};
 
 public:
   //! Nuclear potential
@@ -182,9 +189,21 @@ public: // const methods: "views" into WF object
   std::vector<double> coreDensity() const;
 
   //! Performs hartree-Fock procedure for core: note: poplulates core
+  //! @details If readwrite is true, will read HF core from file, if it exists
+  //! and was calculated with identical inputs (grid, nuclear potential, QED,
+  //! alpha, core, method, Breit, convergence); otherwise solves HF and writes
+  //! file. File name includes a hash of the inputs.
   void hartreeFockCore(const std::string &method = "HartreeFock",
                        const double x_Breit = 0.0,
                        const std::string &in_core = "", double eps_HF = 0,
+                       bool print = true, bool readwrite = false);
+
+  //! Performs hartree-Fock procedure for core, starting from the core orbitals
+  //! of wf0 instead of from scratch. wf0 must use the same grid, and should
+  //! differ only slightly (e.g., nearby isotope). note: poplulates core
+  void hartreeFockCore(const Wavefunction &wf0,
+                       const std::string &method = "HartreeFock",
+                       const double x_Breit = 0.0, double eps_HF = 0,
                        bool print = true);
 
   //! Calculates HF core energy (doesn't include magnetic QED?)
@@ -206,7 +225,7 @@ public: // const methods: "views" into WF object
   //! Calculates radiative potential. Stores in vnuc, and Hmag
   void radiativePotential(QED::RadPot::Scale s, double rcut, double scale_rN,
                           const std::vector<double> &x_spd,
-                          bool do_readwrite = true, bool print = true);
+                          bool do_readwrite = false, bool print = true);
   // void radiativePotential(double x_simple, double x_Ueh, double x_SEe_h,
   //                         double x_SEe_l, double x_SEm, double rcut,
   //                         double scale_rN, const std::vector<double> &x_spd,
@@ -231,11 +250,15 @@ public: // const methods: "views" into WF object
                  const bool holeParticleQ = false, const int lmax = 6,
                  const bool GreenBasis = false, const bool PolBasis = false,
                  const double omre = -0.2, double w0 = 0.01,
-                 double wratio = 1.5);
+                 double wratio = 1.5, const bool single_precision = false,
+                 const double omega_tol = 0.0, const double rank_tol = 0.0);
   void copySigma(const MBPT::CorrelationPotential *const Sigma) {
     if (Sigma != nullptr)
       m_Sigma = std::make_unique<MBPT::CorrelationPotential>(*Sigma);
   }
+  //! Uses the same Sigma as wf, rather than a copy (saves memory). Sigma must
+  //! then not be modified (e.g., scaled) by either Wavefunction
+  void shareSigma(const Wavefunction &wf) { m_Sigma = wf.m_Sigma; }
 
   //! @brief Solves Dirac bound state problem, with optional 'extra' potential
   //! log_eps is log_10(convergence_target).
@@ -278,6 +301,12 @@ public: // const methods: "views" into WF object
 
 private:
   void determineCore(const std::string &str_core_in);
+  // Hash of all inputs that determine HF core (for HF core file)
+  std::uint64_t hfCore_hash(const std::string &method, double x_Breit,
+                            double eps_HF) const;
+  // Reads/writes HF core orbitals (and vdir) from/to file
+  bool hfCore_read_write(const std::string &fname, std::uint64_t hash,
+                         IO::FRW::RoW rw);
   static std::vector<std::size_t>
   sortedEnergyList(const std::vector<DiracSpinor> &tmp_orbs,
                    bool do_sort = false);
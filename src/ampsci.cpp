@@ -1,23 +1,103 @@
 #include "IO/ChronoTimer.hpp"
 #include "IO/FRW_fileReadWrite.hpp" //for 'ExtraPotential'
 #include "IO/InputBlock.hpp"
+#include "Maths/Grid.hpp"
 #include "Maths/Interpolator.hpp" //for 'ExtraPotential'
 #include "Modules/runModules.hpp"
 #include "Physics/include.hpp"
 #include "Wavefunction/Wavefunction.hpp"
 #include "git.info"
 #include "qip/Vector.hpp"
+#include <cstdio>
+#include <fcntl.h> // open (for redirecting output in batch mode)
 #include <iostream>
+#include <memory>
 #include <string>
+#include <unistd.h> // dup, dup2 (for redirecting output in batch mode)
+#include <utility>
+#include <vector>
 
-void ampsci(const IO::InputBlock &input);
+// Grids (and the parameters they were formed from), shared in batch mode
+using GridList =
+    std::vector<std::pair<GridParameters, std::shared_ptr<const Grid>>>;
+
+void ampsci(const IO::InputBlock &input, GridList *grids = nullptr);
+IO::InputBlock read_input(const std::string &input_text);
+
+//******************************************************************************
+// Redirects stdout (std::cout and printf) to a file, until destroyed.
+// If the file cannot be opened, stdout is left alone
+class RedirectStdout {
+  int m_saved_fd; // original stdout (-1 if not redirected)
+
+public:
+  explicit RedirectStdout(const std::string &fname)
+      : m_saved_fd(redirect(fname)) {}
+  RedirectStdout(const RedirectStdout &) = delete;
+  RedirectStdout &operator=(const RedirectStdout &) = delete;
+  ~RedirectStdout() {
+    if (m_saved_fd < 0)
+      return;
+    std::cout << std::flush;
+    std::fflush(stdout);
+    dup2(m_saved_fd, fileno(stdout));
+    close(m_saved_fd);
+  }
+
+private:
+  // Points stdout to fname; returns a copy of the original stdout (or -1)
+  static int redirect(const std::string &fname) {
+    const auto fd = open(fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      std::cerr << "\nCannot write to " << fname << "; using stdout\n";
+      return -1;
+    }
+    std::cout << std::flush;
+    std::fflush(stdout);
+    const auto saved_fd = dup(fileno(stdout));
+    dup2(fd, fileno(stdout));
+    close(fd);
+    return saved_fd;
+  }
+};
+
+//******************************************************************************
 int main(int argc, char *argv[]) {
   std::cout << "ampsci git:" << GitInfo::gitversion << " ("
             << GitInfo::gitbranch << ")\n";
   std::cout << IO::time_date() << '\n';
 
-  const std::string input_text = (argc > 1) ? argv[1] : "ampsci.in";
+  if (argc <= 2) {
+    const std::string input_text = (argc > 1) ? argv[1] : "ampsci.in";
+    ampsci(read_input(input_text));
+    return 0;
+  }
+
+  // Batch mode: several input files. Run one after the other, in the same
+  // process (sharing OpenMP threads, and grids where possible), each writing
+  // its output to its own file: 'inputFile.out'
+  GridList grids;
+  std::cout << "Batch mode: " << argc - 1 << " jobs\n";
+  for (int i = 1; i < argc; ++i) {
+    const std::string input_text = argv[i];
+    const auto out_name = input_text + ".out";
+    std::cout << input_text << " -> " << out_name << std::flush;
+    IO::ChronoTimer timer("");
+    {
+      RedirectStdout redirect(out_name);
+      std::cout << "ampsci git:" << GitInfo::gitversion << " ("
+                << GitInfo::gitbranch << ")\n";
+      std::cout << IO::time_date() << '\n';
+      ampsci(read_input(input_text), &grids);
+    }
+    std::cout << " : " << timer.reading_str() << "\n";
+  }
+
+  return 0;
+}
 
+//******************************************************************************
+IO::InputBlock read_input(const std::string &input_text) {
   // std::filesystem not available in g++-7 (getafix version)
   // Reading from a file? Or from command-line?
   const auto fstream = std::fstream(input_text);
@@ -29,17 +109,12 @@ int main(int argc, char *argv[]) {
                                               "]; valence = 2sp;}"
                                         : input_text;
 
-  const auto input = fstream.good() ? IO::InputBlock("ampsci", fstream)
-                                    : IO::InputBlock("ampsci", default_input);
-
-  // Run program. Add option to run multiple times
-  ampsci(input);
-
-  return 0;
+  return fstream.good() ? IO::InputBlock("ampsci", fstream)
+                        : IO::InputBlock("ampsci", default_input);
 }
 
 //******************************************************************************
-void ampsci(const IO::InputBlock &input) {
+void ampsci(const IO::InputBlock &input, GridList *grids) {
   using namespace std::string_literals;
   IO::ChronoTimer timer("\nampsci");
   std::cout << "\n";
@@ -111,9 +186,22 @@ void ampsci(const IO::InputBlock &input) {
           ? "pointlike"
           : input.get<std::string>({"Nucleus"}, "type", "Fermi");
 
-  // Create wavefunction object
-  Wavefunction wf({num_points, r0, rmax, b, grid_type, du},
-                  {atom_Z, atom_A, nuc_type, rrms, t_skin}, var_alpha);
+  // Create wavefunction object. Re-use grid if have one with same parameters
+  const GridParameters grid_params{num_points, r0, rmax, b, grid_type, du};
+  const auto grid = [&]() {
+    if (grids == nullptr)
+      return std::make_shared<const Grid>(grid_params);
+    for (const auto &[gp, g] : *grids) {
+      if (gp.num_points == grid_params.num_points && gp.r0 == grid_params.r0 &&
+          gp.rmax == grid_params.rmax && gp.b == grid_params.b &&
+          gp.type == grid_params.type)
+        return g;
+    }
+    return grids->emplace_back(grid_params,
+                               std::make_shared<const Grid>(grid_params))
+        .second;
+  }();
+  Wavefunction wf(grid, {atom_Z, atom_A, nuc_type, rrms, t_skin}, var_alpha);
 
   std::cout << "\nRunning for " << wf.atom() << "\n"
             << wf.nuclearParams() << "\n"
@@ -128,7 +216,8 @@ void ampsci(const IO::InputBlock &input) {
        {"convergence", "HF convergance goal, 1e-12"},
        {"method", "HartreeFock(default), Hartree, KohnSham"},
        {"Breit", "Scale for Breit. 0.0 default (no Breit), 1.0 include Breit"},
-       {"sortOutput", "Sort energy tables by energy? (default=false)"}});
+       {"sortOutput", "Sort energy tables by energy? (default=false)"},
+       {"readwrite", "Read/write HF core from/to .hf file (default=false)"}});
 
   if (!input_ok) {
     std::cout
@@ -138,6 +227,7 @@ void ampsci(const IO::InputBlock &input) {
 
   const auto str_core = input.get<std::string>({"HartreeFock"}, "core", "[]");
   const auto eps_HF = input.get({"HartreeFock"}, "convergence", 1.0e-12);
+  const bool hf_rw = input.get({"HartreeFock"}, "readwrite", false);
   const auto HF_method =
       input.get<std::string>({"HartreeFock"}, "method", "HartreeFock");
   if (HF_method == "Hartree")
@@ -176,7 +266,8 @@ void ampsci(const IO::InputBlock &input) {
        {"rcut", "Maximum r to calculate Rad Pot (~5)"},
        {"scale_rN", "Nuclear size. 0 for pointlike, 1 for typical"},
        {"scale_l", "Extra scaling factor for each l e.g., (1,1,1)"},
-       {"core_qed", "Include rad pot into core Hartree-Fock (default=true)"}});
+       {"core_qed", "Include rad pot into core Hartree-Fock (default=true)"},
+       {"readwrite", "Read/write potential from/to .qed file (default=false)"}});
   // const auto include_qed = input.get({"RadPot"}, "RadPot", false);
 
   const auto include_qed = input.getBlock("RadPot") != std::nullopt;
@@ -190,10 +281,11 @@ void ampsci(const IO::InputBlock &input) {
   const auto scale_rN = input.get({"RadPot"}, "scale_rN", 1.0);
   const auto x_spd = input.get({"RadPot"}, "scale_l", std::vector{1.0});
   const bool core_qed = input.get({"RadPot"}, "core_qed", true);
+  const bool qed_rw = input.get({"RadPot"}, "readwrite", false);
 
   if (include_qed && qed_ok && core_qed) {
     wf.radiativePotential({x_Ueh, x_SEe_h, x_SEe_l, x_SEm, x_wk}, rcut,
-                          scale_rN, x_spd);
+                          scale_rN, x_spd, qed_rw);
     std::cout << "Including QED into Hartree-Fock core (and valence)\n\n";
   }
 
@@ -222,12 +314,12 @@ void ampsci(const IO::InputBlock &input) {
 
   { // Solve Hartree equations for the core:
     IO::ChronoTimer t(" core");
-    wf.hartreeFockCore(HF_method, x_Breit, str_core, eps_HF);
+    wf.hartreeFockCore(HF_method, x_Breit, str_core, eps_HF, true, hf_rw);
   }
 
   if (include_qed && qed_ok && !core_qed) {
     wf.radiativePotential({x_Ueh, x_SEe_h, x_SEe_l, x_SEm, x_wk}, rcut,
-                          scale_rN, x_spd);
+                          scale_rN, x_spd, qed_rw);
     std::cout << "Including QED into Valence only\n\n";
   }
 
@@ -305,7 +397,9 @@ void ampsci(const IO::InputBlock &input) {
                          "rmax",       "stride",          "each_valence",
                          "Feynman",    "screening",       "holeParticle",
                          "lmax",       "basis_for_Green", "basis_for_pol",
-                         "real_omega", "imag_omega",      "include_G"});
+                         "real_omega", "imag_omega",      "include_G",
+                         "single_precision", "imag_omega_tol",
+                         "rank_tol"});
   const bool do_energyShifts =
       input.get({"Correlations"}, "energyShifts", false);
   const bool do_brueckner = input.get({"Correlations"}, "Brueckner", false);
@@ -329,6 +423,10 @@ void ampsci(const IO::InputBlock &input) {
   const auto PolBasis = input.get({"Correlations"}, "basis_for_pol", false);
   const auto each_valence = input.get({"Correlations"}, "each_valence", false);
   const auto include_G = input.get({"Correlations"}, "include_G", false);
+  const auto single_precision =
+      input.get({"Correlations"}, "single_precision", false);
+  const auto omega_tol = input.get({"Correlations"}, "imag_omega_tol", 0.0);
+  const auto rank_tol = input.get({"Correlations"}, "rank_tol", 0.0);
   // force sigma_omre to be always -ve
   const auto sigma_omre = -std::abs(
       input.get({"Correlations"}, "real_omega", -0.33 * wf.energy_gap()));
@@ -371,7 +469,8 @@ void ampsci(const IO::InputBlock &input) {
     wf.formSigma(n_min_core, do_brueckner, sigma_rmin, sigma_rmax, sigma_stride,
                  each_valence, include_G, lambda_k, fk, sigma_read, sigma_write,
                  sigma_Feynman, sigma_Screening, hole_particle, sigma_lmax,
-                 GreenBasis, PolBasis, sigma_omre, w0, wratio);
+                 GreenBasis, PolBasis, sigma_omre, w0, wratio,
+                 single_precision, omega_tol, rank_tol);
   }
 
   // Calculate + print second-order energy shifts
@@ -0,0 +1,453 @@
+#include "Angular/Angular_369j.hpp"
+#include "Coulomb/Coulomb.hpp"
+#include "DiracODE/DiracODE.hpp"
+#include "HF/HartreeFock.hpp"
+#include "IO/ChronoTimer.hpp"
+#include "MBPT/CorrelationPotential.hpp"
+#include "MBPT/FeynmanSigma.hpp"
+#include "MBPT/GreenMatrix.hpp"
+#include "MBPT/TensorProduct.hpp"
+#include "Maths/Grid.hpp"
+#include "Maths/NumCalc_quadIntegrate.hpp"
+#include "Wavefunction/BSplineBasis.hpp"
+#include "Wavefunction/DiracSpinor.hpp"
+#include "Wavefunction/Wavefunction.hpp"
+#include "git.info"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#if defined(_OPENMP)
+#include <omp.h>
+#else
+#define omp_get_max_threads() 1
+#define omp_set_num_threads(n) (void)(n)
+#endif
+
+/*
+Timings of (performance-critical) numerical kernels.
+
+Usage: ./benchmarks [options] [n1 n2 ...]
+ - n: sub-grid sizes (number of radial points) for the Green's-function
+   (matrix) kernels. Default: 200 300 400 500
+ - kernels=a,b,..: Only run these kernels. Default: all of
+   tensor_5_product, yk_ab, integrate, integrate_fg, boundState, vexFa,
+   Green_hf, fill_Hamiltonian_matrix
+ - atoms=Cs,Fr: Systems (standard HF core + grid) for the atomic kernels.
+   Default: Cs
+ - threads=1,2,4: Number of threads to sweep over. Default: 1,2,4,..,max
+ - repeat=N: Number of timed repeats (each kernel is first called once,
+   untimed, as a warm-up). Default: 5
+ - csv=file: Also write results to file (csv: one line per kernel, system,
+   and number of threads), for comparison between commits
+ - The slow reference version of tensor_5_product is only run for n <= 300
+
+Kernels that are parallelised internally (OpenMP) are run once with the given
+number of threads ("parallel"). Serial kernels are run concurrently, one copy on
+each thread ("concurrent"): ideal scaling is a constant time.
+*/
+
+namespace Benchmark {
+
+//******************************************************************************
+struct Kernel {
+  std::string name;
+  std::string system; // e.g., "Cs", or matrix size
+  bool parallel;      // parallelised internally (else, run concurrently)
+  std::function<double()> f;
+};
+
+struct Timing {
+  double min, median, mean;
+};
+
+// Stops compiler from optimising away the kernel calls
+thread_local volatile double sink = 0.0;
+
+//------------------------------------------------------------------------------
+// Calls f once (warm-up, not timed), then 'repeat' times; in ms
+Timing time_kernel(const Kernel &kernel, int threads, std::size_t repeat) {
+  omp_set_num_threads(threads);
+  const auto run = [&]() {
+    if (kernel.parallel) {
+      sink = kernel.f();
+    } else {
+#pragma omp parallel num_threads(threads)
+      { sink = kernel.f(); }
+    }
+  };
+
+  run();
+  std::vector<double> t;
+  for (auto i = 0ul; i < repeat; ++i) {
+    IO::ChronoTimer timer;
+    run();
+    t.push_back(timer.reading_ms());
+  }
+  std::sort(begin(t), end(t));
+  const auto median = t.size() % 2 == 1
+                          ? t[t.size() / 2]
+                          : 0.5 * (t[t.size() / 2 - 1] + t[t.size() / 2]);
+  const auto mean = std::accumulate(cbegin(t), cend(t), 0.0) / double(t.size());
+  return {t.front(), median, mean};
+}
+
+//******************************************************************************
+// Fills ff part of matrix with random numbers in [-1,1]; real if im=false
+void fill_random(MBPT::ComplexGMatrix *g, std::mt19937 &rng, bool im = true) {
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for (auto i = 0ul; i < g->size; ++i) {
+    for (auto j = 0ul; j < g->size; ++j) {
+      const auto y = im ? dist(rng) : 0.0;
+      g->ff[i][j] = MBPT::ComplexDouble{dist(rng), y}.val;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Largest |a-b|, relative to largest |b|
+double rel_diff(const MBPT::GMatrix &a, const MBPT::GMatrix &b) {
+  double max_diff = 0.0, max_b = 0.0;
+  for (auto i = 0ul; i < a.size; ++i) {
+    for (auto j = 0ul; j < a.size; ++j) {
+      max_diff = std::max(max_diff, std::abs(a.ff[i][j] - b.ff[i][j]));
+      max_b = std::max(max_b, std::abs(b.ff[i][j]));
+    }
+  }
+  return max_b == 0.0 ? 0.0 : max_diff / max_b;
+}
+
+//******************************************************************************
+// MBPT::tensor_5_product (Feynman exchange); checks against reference (loop)
+// version for n <= max_n_ref (and times it)
+std::vector<Kernel> tensor_5_product(std::size_t n, bool c_real,
+                                     std::size_t max_n_ref) {
+  std::mt19937 rng(1234);
+  using CGM = MBPT::ComplexGMatrix;
+  std::vector<std::shared_ptr<CGM>> m;
+  for (int i = 0; i < 5; ++i) {
+    m.push_back(std::make_shared<CGM>(n, false));
+    fill_random(m.back().get(), rng);
+  }
+  if (c_real)
+    fill_random(m[2].get(), rng, false);
+  const MBPT::ComplexDouble factor{0.3, -0.7};
+
+  const auto system =
+      "n=" + std::to_string(n) + (c_real ? " c:real" : " c:complex");
+
+  const auto product = [=]() {
+    MBPT::GMatrix res(n, false);
+    MBPT::tensor_5_product(&res, factor, *m[0], *m[1], *m[2], *m[3], *m[4]);
+    return res.ff[0][0];
+  };
+  const auto product_ref = [=]() {
+    MBPT::GMatrix res(n, false);
+    MBPT::tensor_5_product_ref(&res, factor, *m[0], *m[1], *m[2], *m[3],
+                               *m[4]);
+    return res.ff[0][0];
+  };
+
+  std::vector<Kernel> kernels{{"tensor_5_product", system, false, product}};
+  if (n <= max_n_ref) {
+    MBPT::GMatrix res(n, false), res_ref(n, false);
+    MBPT::tensor_5_product(&res, factor, *m[0], *m[1], *m[2], *m[3], *m[4]);
+    MBPT::tensor_5_product_ref(&res_ref, factor, *m[0], *m[1], *m[2], *m[3],
+                               *m[4]);
+    printf("tensor_5_product  %s  eps=%.1e\n", system.c_str(),
+           rel_diff(res, res_ref));
+    kernels.push_back({"tensor_5_product_ref", system, false, product_ref});
+  }
+  return kernels;
+}
+
+//******************************************************************************
+// Standard (HF) systems, with grids as typically used in practice
+std::unique_ptr<Wavefunction> make_system(const std::string &atom) {
+  const auto core = atom == "Fr" ? "[Rn]" : "[Xe]";
+  const auto valence = atom == "Fr" ? "7sp6d" : "6sp5d";
+  auto wf = std::make_unique<Wavefunction>(
+      GridParameters{4000, 1.0e-6, 150.0, 0.33 * 150.0, "loglinear", -1.0},
+      Nuclear::Parameters{atom, -1, "Fermi", -1.0, -1.0}, 1.0);
+  wf->hartreeFockCore("HartreeFock", 0.0, core);
+  wf->hartreeFockValence(valence);
+  return wf;
+}
+
+//------------------------------------------------------------------------------
+// y^k_ab, for every pair of core orbitals, all allowed k
+double yk_ab_core(const std::vector<DiracSpinor> &core) {
+  std::vector<double> yk;
+  double x = 0.0;
+  for (auto ia = 0ul; ia < core.size(); ++ia) {
+    for (auto ib = 0ul; ib <= ia; ++ib) {
+      const auto &Fa = core[ia];
+      const auto &Fb = core[ib];
+      const auto kmax = (Fa.twoj() + Fb.twoj()) / 2;
+      for (int k = 0; k <= kmax; ++k) {
+        if (Angular::Ck_kk_SR(k, Fa.k, Fb.k)) {
+          Coulomb::yk_ab(Fa, Fb, k, yk);
+          x += yk.back();
+        }
+      }
+    }
+  }
+  return x;
+}
+
+// Radial integrals <a|b>, for a in core+valence, b in core
+double integrate_all(const Wavefunction &wf) {
+  const auto &dr = wf.rgrid->drdu;
+  double x = 0.0;
+  for (const auto *orbs : {&wf.core, &wf.valence}) {
+    for (const auto &Fa : *orbs) {
+      for (const auto &Fb : wf.core) {
+        x += NumCalc::integrate(1.0, 0, 0, Fa.f, Fb.f, dr) +
+             NumCalc::integrate(1.0, 0, 0, Fa.g, Fb.g, dr);
+      }
+    }
+  }
+  return x;
+}
+
+// As integrate_all, but f and g parts fused into a single pass
+double integrate_fg_all(const Wavefunction &wf) {
+  const auto &dr = wf.rgrid->drdu;
+  double x = 0.0;
+  for (const auto *orbs : {&wf.core, &wf.valence}) {
+    for (const auto &Fa : *orbs) {
+      for (const auto &Fb : wf.core) {
+        x += NumCalc::integrate_fg(1.0, 0, 0, Fa.f, Fb.f, Fa.g, Fb.g, dr);
+      }
+    }
+  }
+  return x;
+}
+
+// Solves local Dirac equation (HF direct potential, vl[l]) for each valence
+// state, starting from a poor energy guess
+double boundState_valence(const Wavefunction &wf,
+                          const std::vector<std::vector<double>> &vl) {
+  double x = 0.0;
+  for (const auto &Fv : wf.valence) {
+    auto Fa = Fv;
+    DiracODE::boundState(Fa, 0.9 * Fv.en, vl[std::size_t(Fv.l())], {},
+                         wf.alpha);
+    x += Fa.en;
+  }
+  return x;
+}
+
+// Exchange potential (calculated from scratch), for each valence state
+double vexFa_valence(const Wavefunction &wf) {
+  double x = 0.0;
+  for (const auto &Fv : wf.valence) {
+    x += HF::vexFa(Fv, wf.core) * Fv;
+  }
+  return x;
+}
+
+//------------------------------------------------------------------------------
+// Atomic kernels, for given system. Each call does a "realistic" unit of work
+std::vector<Kernel> atomic_kernels(const Wavefunction &wf,
+                                   const std::string &atom,
+                                   const std::vector<std::string> &names) {
+  const auto want = [&](const std::string &name) {
+    return names.empty() ||
+           std::find(cbegin(names), cend(names), name) != cend(names);
+  };
+  const auto *p_wf = &wf;
+
+  std::vector<Kernel> kernels;
+  if (want("yk_ab"))
+    kernels.push_back(
+        {"yk_ab", atom, false, [p_wf]() { return yk_ab_core(p_wf->core); }});
+
+  if (want("integrate"))
+    kernels.push_back(
+        {"integrate", atom, false, [p_wf]() { return integrate_all(*p_wf); }});
+
+  if (want("integrate_fg"))
+    kernels.push_back({"integrate_fg", atom, false,
+                       [p_wf]() { return integrate_fg_all(*p_wf); }});
+
+  if (want("boundState")) {
+    auto vl = std::make_shared<std::vector<std::vector<double>>>();
+    for (int l = 0; l <= DiracSpinor::max_l(wf.valence); ++l)
+      vl->push_back(wf.get_Vlocal(l));
+    kernels.push_back({"boundState", atom, false, [p_wf, vl]() {
+                         return boundState_valence(*p_wf, *vl);
+                       }});
+  }
+
+  if (want("vexFa"))
+    kernels.push_back(
+        {"vexFa", atom, false, [p_wf]() { return vexFa_valence(*p_wf); }});
+
+  // Spline basis Hamiltonian matrix (includes HF exchange), kappa=-1
+  if (want("fill_Hamiltonian_matrix")) {
+    const auto spl = std::make_shared<std::vector<DiracSpinor>>(
+        SplineBasis::form_spline_basis(-1, 40, 7, 1.0e-5, 40.0, wf.rgrid,
+                                       wf.alpha));
+    kernels.push_back({"fill_Hamiltonian_matrix", atom, true, [p_wf, spl]() {
+                         const auto [H, S] =
+                             SplineBasis::fill_Hamiltonian_matrix(*spl, *p_wf);
+                         return H[0][0] + S[0][0];
+                       }});
+  }
+
+  return kernels;
+}
+
+//------------------------------------------------------------------------------
+// HF Green's function (with exchange), at complex energy, on the Sigma
+// sub-grid. Small Feynman setup (lmax=1, coarse omega grid): setup not timed
+std::vector<Kernel> green_kernels(Wavefunction &wf, const std::string &atom,
+                                  std::vector<std::shared_ptr<void>> *keep) {
+  wf.formBasis({"30spd", 40, 7, 0.0, 1.0e-6, 40.0, false});
+  MBPT::Sigma_params sigp{MBPT::Method::Feynman, 3, false, 1};
+  sigp.w0 = 0.1;
+  sigp.w_ratio = 4.0;
+  const auto sigma = std::make_shared<MBPT::FeynmanSigma>(
+      wf.getHF(), wf.basis, sigp, MBPT::rgrid_params{1.0e-4, 30.0, 8}, "");
+  keep->push_back(sigma);
+
+  std::vector<Kernel> kernels;
+  for (const auto kappa : {-1, 1, -2}) {
+    kernels.push_back({"Green_hf",
+                       atom + " kappa=" + std::to_string(kappa) +
+                           " n=" + std::to_string(sigma->get_dri().size),
+                       false, [sigma, kappa]() {
+                         const auto g = sigma->Green(
+                             kappa, {-0.2, 0.05}, MBPT::States::both,
+                             MBPT::GrMethod::Green);
+                         return MBPT::ComplexDouble(g.ff[0][0]).cre();
+                       }});
+  }
+  return kernels;
+}
+
+//------------------------------------------------------------------------------
+std::vector<std::string> split(const std::string &s) {
+  std::vector<std::string> out;
+  std::size_t beg = 0;
+  while (beg <= s.size()) {
+    const auto end = std::min(s.find(',', beg), s.size());
+    if (end > beg)
+      out.push_back(s.substr(beg, end - beg));
+    beg = end + 1;
+  }
+  return out;
+}
+
+} // namespace Benchmark
+
+//******************************************************************************
+int main(int argc, char *argv[]) {
+  using namespace Benchmark;
+
+  std::vector<std::size_t> sizes;
+  std::vector<std::string> names, atoms{"Cs"};
+  std::vector<int> thread_list;
+  std::size_t repeat = 5;
+  std::string csv_file;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const auto eq = arg.find('=');
+    if (eq == std::string::npos) {
+      sizes.push_back(std::stoul(arg));
+      continue;
+    }
+    const auto key = arg.substr(0, eq);
+    const auto value = arg.substr(eq + 1);
+    if (key == "kernels") {
+      names = split(value);
+    } else if (key == "atoms") {
+      atoms = split(value);
+    } else if (key == "threads") {
+      for (const auto &t : split(value))
+        thread_list.push_back(std::stoi(t));
+    } else if (key == "repeat") {
+      repeat = std::max(1ul, std::stoul(value));
+    } else if (key == "csv") {
+      csv_file = value;
+    } else {
+      std::printf("Unknown option: %s\n", arg.c_str());
+      return 1;
+    }
+  }
+  if (sizes.empty())
+    sizes = {200, 300, 400, 500};
+  if (thread_list.empty()) {
+    for (int t = 1; t < omp_get_max_threads(); t *= 2)
+      thread_list.push_back(t);
+    thread_list.push_back(omp_get_max_threads());
+  }
+  const std::size_t max_n_ref = 300;
+  const auto want = [&](const std::string &name) {
+    return names.empty() ||
+           std::find(cbegin(names), cend(names), name) != cend(names);
+  };
+
+  std::printf("ampsci benchmarks. git:%s (%s)\n", GitInfo::gitversion,
+              GitInfo::gitbranch);
+
+  // Set up all kernels first (not timed)
+  std::vector<Kernel> kernels;
+  std::vector<std::unique_ptr<Wavefunction>> systems;
+  std::vector<std::shared_ptr<void>> keep;
+  if (want("tensor_5_product")) {
+    for (const auto n : sizes) {
+      for (const auto c_real : {false, true}) {
+        const auto k = tensor_5_product(n, c_real, max_n_ref);
+        kernels.insert(end(kernels), cbegin(k), cend(k));
+      }
+    }
+  }
+  const bool need_atoms =
+      names.empty() ||
+      std::any_of(cbegin(names), cend(names),
+                  [](const auto &x) { return x != "tensor_5_product"; });
+  if (need_atoms) {
+    for (const auto &atom : atoms) {
+      auto &wf = systems.emplace_back(make_system(atom));
+      const auto k = atomic_kernels(*wf, atom, names);
+      kernels.insert(end(kernels), cbegin(k), cend(k));
+      if (want("Green_hf")) {
+        const auto kg = green_kernels(*wf, atom, &keep);
+        kernels.insert(end(kernels), cbegin(kg), cend(kg));
+      }
+    }
+  }
+
+  std::ofstream csv;
+  if (!csv_file.empty()) {
+    csv.open(csv_file);
+    csv << "kernel,system,mode,threads,repeat,min_ms,median_ms,mean_ms\n";
+  }
+
+  std::printf("\n%-24s %-24s %-10s %3s %12s %12s %12s\n", "kernel", "system",
+              "mode", "thr", "min/ms", "median/ms", "mean/ms");
+  for (const auto &kernel : kernels) {
+    const auto mode = kernel.parallel ? "parallel" : "concurrent";
+    for (const auto threads : thread_list) {
+      const auto [t_min, t_median, t_mean] =
+          time_kernel(kernel, threads, repeat);
+      std::printf("%-24s %-24s %-10s %3d %12.3f %12.3f %12.3f\n",
+                  kernel.name.c_str(), kernel.system.c_str(), mode, threads,
+                  t_min, t_median, t_mean);
+      std::fflush(stdout);
+      if (csv.is_open()) {
+        csv << kernel.name << "," << kernel.system << "," << mode << ","
+            << threads << "," << repeat << "," << t_min << "," << t_median
+            << "," << t_mean << "\n";
+      }
+    }
+  }
+}
@@ -5,12 +5,14 @@
 #include "Maths/Grid.hpp"
 #include "Maths/NumCalc_quadIntegrate.hpp"
 #include "Physics/PhysConst_constants.hpp"
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #pragma GCC diagnostic ignored "-Wsign-conversion"
@@ -362,27 +364,28 @@ instead
   }
 
   // Calculate <ds.v>/dE for each E (for each mx, mv)
-  std::cout << "Calculating <ds.v>/dE (doing q and v integrations): \n";
+  // The whole (mv, mx) grid (and, for an. mod., both velocity distros) is
+  // scheduled as one collapsed task space. Cost of each point depends strongly
+  // on mx (through vmin), hence dynamic schedule.
+  // Note: no output from inside the parallel region (serialises threads)
+  const std::size_t n_cp = do_anMod ? 2 : 1;
+  std::cout << "Calculating <ds.v>/dE (doing q and v integrations), for "
+            << n_mv * n_mx * n_cp << " (mv, mx) points.. " << std::flush;
+#pragma omp parallel for collapse(3) schedule(dynamic)
   for (std::size_t imv = 0; imv < n_mv; imv++) {
-    double mv = mvgrid.r[imv];
-#pragma omp parallel for
     for (std::size_t imx = 0; imx < n_mx; imx++) {
-      double mx = mxgrid.r[imx];
-      std::cout << "\r .. " << std::flush;
-      if (do_anMod) {
-        form_dsvdE(dsv_mv_mx_E[imv][imx], Kenq, mv, mx, Egrid, qgrid, arr_fv[1],
-                   dv, F_chi_2);
-        std::cout << "\r  ... " << std::flush;
-        form_dsvdE(dsv_mv_mx_Emax[imv][imx], Kenq, mv, mx, Egrid, qgrid,
-                   arr_fv[2], dv, F_chi_2);
-      } else {
-        form_dsvdE(dsv_mv_mx_E[imv][imx], Kenq, mv, mx, Egrid, qgrid, arr_fv[0],
-                   dv, F_chi_2);
-      }
-      std::cout << "\r .. .. " << std::flush;
-    } // mx
-  }   // mv
-  std::cout << "\n";
+      for (std::size_t icp = 0; icp < n_cp; icp++) {
+        const double mv = mvgrid.r[imv];
+        const double mx = mxgrid.r[imx];
+        // an. mod: arr_fv[1] -> dsv(min), arr_fv[2] -> dsv(max)
+        auto &dsv = (icp == 0) ? dsv_mv_mx_E[imv][imx]
+                               : dsv_mv_mx_Emax[imv][imx];
+        const auto &fv = do_anMod ? arr_fv[icp + 1] : arr_fv[0];
+        form_dsvdE(dsv, Kenq, mv, mx, Egrid, qgrid, fv, dv, F_chi_2);
+      } // cp
+    }   // mx
+  }     // mv
+  std::cout << "done\n";
 
   // If doing an. mod, form "amplitude" for ds.v/dE, used below
   if (do_anMod) {
@@ -400,24 +403,78 @@ instead
 }
 
 //******************************************************************************
-std::vector<double>
-convolvedRate(const std::vector<double> &in_rate, const Grid &in_grid,
-              const std::vector<std::vector<double>> &f_conv,
-              double convert_units) {
+struct ResponseMatrix
+/*
+Detector response (smearing + thresholds etc.), stored as a band matrix.
+For each output point i, only the columns [j0, j1) with non-negligible weight
+are stored. Quadrature weights (and Jacobian) of the input grid are included,
+so applying it is just a (banded) matrix-vector product:
+  out_i = sum_j R_ij * in_j  ~  Int[ f_conv_i(E) * in(E) , dE ]
+*/
+{
+  std::vector<std::size_t> j0{};
+  std::vector<std::vector<double>> R{};
+};
 
-  auto Nout = f_conv.size();
+//******************************************************************************
+ResponseMatrix formResponse(const std::vector<std::vector<double>> &f_conv,
+                            const Grid &in_grid, double eps = 1.0e-12)
+// Forms the response matrix from the convolution functions f_conv[i][j], for
+// integration over in_grid. Terms smaller than eps*max are dropped (only at
+// the edges of each row, so each row stays a contiguous band).
+{
+  // Quadrature weights: same as used in NumCalc::integrate
+  const auto num_in = in_grid.num_points;
+  std::vector<double> w(num_in);
+  for (std::size_t j = 0; j < num_in; j++) {
+    const auto wq = j < NumCalc::Nquad
+                        ? NumCalc::cq[j] * NumCalc::dq_inv
+                        : j >= num_in - NumCalc::Nquad
+                              ? NumCalc::cq[num_in - j - 1] * NumCalc::dq_inv
+                              : 1.0;
+    w[j] = wq * in_grid.drdu[j] * in_grid.du;
+  }
 
-  // std::size_t Nout = f_smear.size();
-  std::vector<double> out_rate; //(Nout);
-  out_rate.reserve(Nout);
-  for (std::size_t i = 0; i < Nout; i++) {
-    double g =
-        // NumCalc::integrate({&in_rate, &f_conv[i], &in_grid.drdu},
-        // in_grid.du);
-        NumCalc::integrate(in_grid.du, 0, 0, in_rate, f_conv[i], in_grid.drdu);
-    out_rate.push_back(convert_units * g);
+  ResponseMatrix response;
+  response.j0.reserve(f_conv.size());
+  response.R.reserve(f_conv.size());
+  for (const auto &f : f_conv) {
+    double fmax = 0.0;
+    for (const auto fj : f)
+      fmax = std::max(fmax, std::abs(fj));
+    const auto cut = eps * fmax;
+    std::size_t ja = 0, jb = f.size();
+    while (ja < jb && std::abs(f[ja]) <= cut)
+      ++ja;
+    while (jb > ja && std::abs(f[jb - 1]) <= cut)
+      --jb;
+    std::vector<double> row;
+    row.reserve(jb - ja);
+    for (auto j = ja; j < jb; j++)
+      row.push_back(f[j] * w[j]);
+    response.j0.push_back(ja);
+    response.R.push_back(std::move(row));
   }
+  return response;
+}
 
+//******************************************************************************
+std::vector<double> convolvedRate(const std::vector<double> &in_rate,
+                                  const ResponseMatrix &response,
+                                  double convert_units)
+// Applies the (banded) detector response to input rate, and converts units
+{
+  const auto Nout = response.R.size();
+  std::vector<double> out_rate(Nout);
+  for (std::size_t i = 0; i < Nout; i++) {
+    const auto &row = response.R[i];
+    const auto j0 = response.j0[i];
+    double g = 0.0;
+    for (std::size_t j = 0; j < row.size(); j++) {
+      g += row[j] * in_rate[j0 + j];
+    }
+    out_rate[i] = convert_units * g;
+  }
   return out_rate;
 }
 
@@ -458,11 +515,13 @@ Optionally further integrates into energy bins
 
   // Create the Gaussian-smearing array (includes HW threshold)
   std::vector<std::vector<double>> gausVec(desteps);
+#pragma omp parallel for
   for (std::size_t i = 0; i < desteps; i++) {
     double Eobs = Egrid.r[i];
     double sigma =
         (alpha * std::sqrt(Eobs * E_to_keV) + beta * (Eobs * E_to_keV)) /
         E_to_keV;
+    gausVec[i].reserve(desteps);
     for (auto Eer : Egrid.r) {
       double g = gaussian(sigma, Eobs - Eer);
       if (Eer < E_thresh_HW || Eobs < E_thresh_HW)
@@ -470,6 +529,8 @@ Optionally further integrates into energy bins
       gausVec[i].push_back(g);
     }
   }
+  // Precompute as (banded) response matrix: used for every mv, mx
+  const auto response = formResponse(gausVec, Egrid);
 
   // Array to store observable Rate, S
   DoubleVec3D dSdE_mv_mx_E;
@@ -482,13 +543,14 @@ Optionally further integrates into energy bins
   // Calculate _observable_ rate, S, for DAMA
   // inlcuding Gaussian resolution, + hard-ware threshold
   // Converts units to counts/day/kg/keV
+#pragma omp parallel for collapse(2)
   for (std::size_t imv = 0; imv < n_mv; imv++) {
     for (std::size_t imx = 0; imx < n_mx; imx++) {
       double mx = mxgrid.r[imx];
       double rho_on_mxc2 = rhoDM_GeVcm3 / (mx * M_to_GeV);
       double rate_units = dsvdE_to_cm3keVday * rho_on_mxc2 / MN;
       dSdE_mv_mx_E[imv][imx] =
-          convolvedRate(dsv_mv_mx_E[imv][imx], Egrid, gausVec, rate_units);
+          convolvedRate(dsv_mv_mx_E[imv][imx], response, rate_units);
     }
   }
 
@@ -532,34 +594,37 @@ Optionally further integrates into energy bins
   if (mvgrid.r0 >= 0)
     printf(" ; M_v=%6.3f MeV", mvgrid.r0 * M_to_MeV);
   std::cout << ")\n";
+  // Energy bin index ranges: same for every mx, mv
+  std::vector<std::pair<std::size_t, std::size_t>> bin_index(
+      static_cast<std::size_t>(num_bins));
+  for (int i = 0; i < num_bins; i++) {
+    bin_index[std::size_t(i)] = {Egrid.getIndex(iEbin + i * wEbin),
+                                 Egrid.getIndex(iEbin + (i + 1) * wEbin)};
+  }
+#pragma omp parallel for collapse(2)
   for (std::size_t imv = 0; imv < n_mv; imv++) {
     for (std::size_t imx = 0; imx < n_mx; imx++) {
-      for (int i = 0; i < num_bins; i++) {
-        auto ieA = Egrid.getIndex(iEbin + i * wEbin);
-        auto ieB = Egrid.getIndex(iEbin + (i + 1) * wEbin);
-        // if (ieA < 0)
-        //   ieA = 0;
-
+      for (std::size_t i = 0; i < bin_index.size(); i++) {
+        const auto [ieA, ieB] = bin_index[i];
         double Rate = 0;
         for (auto ie = ieA; ie < ieB; ie++) {
-          // if (ieB >= desteps)
-          //   break;
           double dEdu = Egrid.drdu[ie]; // r[ie];
           Rate += double(dSdE_mv_mx_E[imv][imx][ie]) * dEdu;
           // nb: E is from Jacobian; * dE/E below
         }
         Rate *= Egrid.du / wEbin;
         S_mv_mx_E[imv][imx][i] = Rate;
-        double EaKev = Egrid.r[ieA] * E_to_keV;
-        double EbKev = Egrid.r[ieB] * E_to_keV;
-        if (imv == 0 && imx == 0) {
-          // only print first one to screen
-          printf("%3.1f-%3.1f: %6.3f   %.2e     %i\n", EaKev, EbKev,
-                 0.5 * (EaKev + EbKev), Rate, (int)(ieB - ieA));
-        }
       }
     }
   }
+  // only print first one to screen
+  for (std::size_t i = 0; i < bin_index.size(); i++) {
+    const auto [ieA, ieB] = bin_index[i];
+    double EaKev = Egrid.r[ieA] * E_to_keV;
+    double EbKev = Egrid.r[ieB] * E_to_keV;
+    printf("%3.1f-%3.1f: %6.3f   %.2e     %i\n", EaKev, EbKev,
+           0.5 * (EaKev + EbKev), S_mv_mx_E[0][0][i], (int)(ieB - ieA));
+  }
 
   if (!write_SofM)
     return;
@@ -694,13 +759,15 @@ Mostly, coming from:
 
   // Calculate Poiss-smeared rate, F [mv, mv, n]
   // F has units: counts/kg/day
+  const auto response = formResponse(P, Egrid);
+#pragma omp parallel for collapse(2)
   for (std::size_t imv = 0; imv < n_mv; imv++) {
     for (std::size_t imx = 0; imx < n_mx; imx++) {
       double mx = mxgrid.r[imx];
       double rho_on_mxc2 = rhoDM_GeVcm3 / (mx * M_to_GeV);
       double rate_units = dsvdE_to_cm3_per_auday * rho_on_mxc2 / MN;
       F_mv_mx_n[imv][imx] =
-          convolvedRate(dsv_mv_mx_E[imv][imx], Egrid, P, rate_units);
+          convolvedRate(dsv_mv_mx_E[imv][imx], response, rate_units);
     }
   }
 
@@ -751,6 +818,7 @@ Mostly, coming from:
 
   // Sum over n [F -> dS/ds1]
   // dS/ds1 units: counts/day/kg/PE
+#pragma omp parallel for collapse(2)
   for (std::size_t imv = 0; imv < n_mv; imv++) {
     for (std::size_t imx = 0; imx < n_mx; imx++) {
       for (std::size_t is1 = 0; is1 < num_s1; is1++) {
@@ -786,6 +854,7 @@ Mostly, coming from:
   auto is1_a = s1grid.getIndex(s1_a, true);
   auto is1_b = s1grid.getIndex(s1_b, true);
   std::vector<std::vector<double>> rate(n_mv, std::vector<double>(n_mx));
+#pragma omp parallel for collapse(2)
   for (std::size_t imv = 0; imv < n_mv; imv++) {
     for (std::size_t imx = 0; imx < n_mx; imx++) {
       rate[imv][imx] = NumCalc::integrate(s1grid.du, is1_a, is1_b,
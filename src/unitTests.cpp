@@ -1,6 +1,7 @@
 #include "Angular/Angular_test.hpp"
 #include "Coulomb/Coulomb_test.hpp"
 #include "DiracODE/DiracODE_test.hpp"
+#include "DiracOperator/DiracOperator_test.hpp"
 #include "ExternalField/DiagramRPA_test.hpp"
 #include "ExternalField/MixedStates_test.hpp"
 #include "ExternalField/TDHF_test.hpp"
@@ -12,9 +13,12 @@
 #include "IO/InputBlock.hpp" // for time+date
 #include "MBPT/CorrelationPotential_test.hpp"
 #include "MBPT/StructureRad_test.hpp"
+#include "Maths/Interpolator_test.hpp"
 #include "Maths/LinAlg_test.hpp"
+#include "Modules/isotopeShift_test.hpp"
 #include "Physics/RadPot_test.hpp"
 #include "Wavefunction/BSplineBasis_test.hpp"
+#include "Wavefunction/DiracSpinor_test.hpp"
 #include "git.info"
 #include <cassert>
 #include <iostream>
@@ -56,6 +60,8 @@ static const std::vector<std::pair<std::string, bool (*)(std::ostream &obuff)>>
     test_list{
         //
         {"DiracODE", &DiracODE},
+        {"DiracOperators", &DiracOperators},
+        {"DiracSpinorOps", &DiracSpinorOps},
         {"HartreeFock", &HartreeFock},
         {"Breit", &Breit},
         {"MixedStates", &MixedStates},
@@ -65,10 +71,12 @@ static const std::vector<std::pair<std::string, bool (*)(std::ostream &obuff)>>
         {"RadPot", &RadPot},
         {"Angular", &Angular},
         {"LinAlg", &LinAlg},
+        {"Interpolator", &Interpolator},
         {"BSplineBasis", &BSplineBasis},
         {"Coulomb", &Coulomb},
         {"CorrelationPotential", &CorrelationPotential},
         {"DiagramRPA", &DiagramRPA},
+        {"FieldShift", &FieldShift},
         {"StructureRad", &StructureRad}
         //
     };